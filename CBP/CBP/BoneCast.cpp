@@ -1,6 +1,9 @@
 #include "pch.h"
 
 #include "BoneCast.h"
+#include "BoneCastStore.h"
+#include "SkinModelCache.h"
+#include "VertexWeld.h"
 
 #include "Armor.h"
 #include "Config.h"
@@ -18,10 +21,33 @@ namespace CBP
     IBoneCast IBoneCast::m_Instance;
 
     IBoneCast::IBoneCast() :
-        m_cache(m_iio, 1024 * 1024 * 64)
+        m_cache(m_iio, 1024 * 1024 * 64, 1024 * 1024 * 64)
     {
     }
 
+    void IBoneCast::Release()
+    {
+        m_Instance.m_cache.Release();
+        m_Instance.m_shared.clear();
+        m_Instance.m_pending.clear();
+        m_Instance.m_generation++;
+        m_Instance.ClearPrefetch();
+
+        ISkinModelCache::Release();
+    }
+
+    void IBoneCast::Initialize()
+    {
+        BoneCastStore::GetSingleton().Open();
+    }
+
+    void IBoneCast::Shutdown()
+    {
+        m_Instance.m_worker.Shutdown();
+        m_Instance.m_pending.clear();
+        m_Instance.ClearPrefetch();
+    }
+
     bool IBoneCast::ExtractGeometry(
         Actor* a_actor,
         const BSFixedString& a_nodeName,
@@ -129,38 +155,29 @@ namespace CBP
 
             Bullet::btTransformEx tnsf(boneData.m_kSkinToBone);
 
-            auto tris = std::make_unique<Triangle[]>(numTriangles);
-            auto vertmap = std::make_unique<Vertex[]>(numVertices);
+            // a triangle belongs to the bone if any of its vertices does, so
+            // flat per-vertex arrays replace the vertex -> triangle adjacency
+            auto& scratch = m_Instance.m_extractScratch;
 
-            for (decltype(numPartitions) i = 0, itri = 0; i < numPartitions; i++)
+            scratch.weights.assign(numVertices, -1.0f);
+            scratch.boneVertex.assign(numVertices, 0);
+            scratch.remap.assign(numVertices, std::numeric_limits<std::uint32_t>::max());
+            scratch.vertices.clear();
+            scratch.indices.clear();
+
+            for (decltype(numPartitions) i = 0; i < numPartitions; i++)
             {
                 auto& part = skinPartition->m_pkPartitions[i];
 
                 auto trilist = part.m_pusTriList;
-                auto numTris = part.m_usTriangles;
+                std::uint32_t numIndices = part.m_usTriangles * 3;
 
-                for (decltype(numTris) j = 0; j < numTris; j++)
+                for (decltype(numIndices) j = 0; j < numIndices; j++)
                 {
-                    auto tri = std::addressof(tris[itri]);
-
-                    tri->m_isBoneTri = false;
-
-                    std::uint32_t k = j * 3;
-
-                    auto i1 = tri->m_indices[0] = trilist[k];
-                    auto i2 = tri->m_indices[1] = trilist[k + 1];
-                    auto i3 = tri->m_indices[2] = trilist[k + 2];
-
-                    if (i1 >= numVertices || i2 >= numVertices || i3 >= numVertices) {
+                    if (trilist[j] >= numVertices) {
                         m_Instance.Warning("%s: [m_pusTriList] index >= numVertices", a_nodeName.c_str());
                         return false;
                     }
-
-                    vertmap[i1].m_triangles.emplace_back(tri);
-                    vertmap[i2].m_triangles.emplace_back(tri);
-                    vertmap[i3].m_triangles.emplace_back(tri);
-
-                    itri++;
                 }
             }
 
@@ -173,31 +190,35 @@ namespace CBP
                     return false;
                 }
 
-                auto& d = vertmap[v.m_usVert];
-
-                d.m_weight = v.m_fWeight;
-
-                for (auto& e : d.m_triangles)
-                    e->m_isBoneTri = true;
-
+                scratch.weights[v.m_usVert] = v.m_fWeight;
+                scratch.boneVertex[v.m_usVert] = 1;
             }
 
-            std::size_t c = 0;
             std::uint32_t vi = 0;
 
-            for (decltype(numTriangles) i = 0; i < numTriangles; i++)
+            for (decltype(numPartitions) i = 0; i < numPartitions; i++)
             {
-                auto& tri = tris[i];
+                auto& part = skinPartition->m_pkPartitions[i];
+
+                auto trilist = part.m_pusTriList;
+                std::uint32_t numIndices = part.m_usTriangles * 3;
 
-                if (tri.m_isBoneTri) {
+                for (decltype(numIndices) j = 0; j < numIndices; j += 3)
+                {
+                    if (!scratch.boneVertex[trilist[j]] &&
+                        !scratch.boneVertex[trilist[j + 1]] &&
+                        !scratch.boneVertex[trilist[j + 2]])
+                    {
+                        continue;
+                    }
 
-                    for (int j = 0; j < 3; j++)
+                    for (decltype(j) k = j; k < j + 3; k++)
                     {
-                        auto index = tri.m_indices[j];
+                        auto index = trilist[k];
 
-                        auto& vme = vertmap[index];
+                        auto& e = scratch.remap[index];
 
-                        if (!vme.m_hasVertex)
+                        if (e == std::numeric_limits<std::uint32_t>::max())
                         {
                             btVector3 vtx;
 
@@ -208,74 +229,39 @@ namespace CBP
                                 vtx = *reinterpret_cast<DirectX::XMVECTOR*>(&partition->shapeData->m_RawVertexData[index * vertexSize]);
                             }
 
-                            vme.m_vertex.v = tnsf * vtx;
-                            vme.m_hasVertex = true;
-                            vme.m_index = vi;
+                            scratch.vertices.emplace_back().v = tnsf * vtx;
 
-                            tri.m_indices[j] = vi;
-
-                            vi++;
-                        }
-                        else {
-                            tri.m_indices[j] = vme.m_index;
+                            e = vi++;
                         }
 
-                        /*if (vme.m_weight < 0.0f)
-                            vme.m_weight = 0.0f;*/
+                        scratch.indices.emplace_back(e);
                     }
-
-                    c++;
                 }
             }
 
-            if (c == 0 || vi == 0)
+            if (scratch.indices.empty() || vi == 0)
                 return false;
 
-            auto rnIndices = c * 3;
             auto rnVertices = static_cast<std::size_t>(vi);
 
             a_out.m_vertices = std::make_unique_for_overwrite<MeshPoint[]>(rnVertices);
             a_out.m_weights.resize(rnVertices);
-            a_out.m_indices.resize(rnIndices);
-
-            for (decltype(numVertices) i = 0; i < numVertices; i++) {
-
-                auto& vme = vertmap[i];
-
-                if (vme.m_hasVertex)
-                {
-                    auto index = vme.m_index;
-
-                    ASSERT(index < rnVertices);
-
-                    a_out.m_vertices[index].v = vme.m_vertex.v;
-                    a_out.m_weights[index] = vme.m_weight;
-                }
-            }
 
-            a_out.m_numVertices = static_cast<unsigned int>(rnVertices);
+            std::memcpy(a_out.m_vertices.get(), scratch.vertices.data(), sizeof(MeshPoint) * rnVertices);
 
-            for (decltype(numTriangles) i = 0, c = 0; i < numTriangles; i++)
+            for (decltype(numVertices) i = 0; i < numVertices; i++)
             {
-                auto& tri = tris[i];
-
-                if (tri.m_isBoneTri) {
-
-                    for (int j = 0; j < 3; j++) 
-                    {
-                        auto index = tri.m_indices[j];
-
-                        ASSERT(c < rnIndices);
-
-                        a_out.m_indices[c] = index;
-
-                        c++;
-                    }
+                auto index = scratch.remap[i];
 
+                if (index != std::numeric_limits<std::uint32_t>::max()) {
+                    a_out.m_weights[index] = scratch.weights[i];
                 }
             }
 
-            a_out.m_numTriangles = static_cast<int>(rnIndices / 3);
+            a_out.m_indices.assign(scratch.indices.begin(), scratch.indices.end());
+
+            a_out.m_numVertices = static_cast<unsigned int>(rnVertices);
+            a_out.m_numTriangles = static_cast<int>(scratch.indices.size() / 3);
 
             return true;
 
@@ -284,212 +270,57 @@ namespace CBP
         return false;
     }
 
-    void IBoneCast::RemoveDuplicateVertices(
-        const MeshPoint* a_vertices,
-        Eigen::Index a_numVertices,
-        const unsigned int* a_indices,
-        Eigen::Index a_numFaces,
-        Eigen::MatrixXf& a_verticesOut,
-        Eigen::MatrixXi& a_indicesOut)
-    {
-        Eigen::MatrixXf OV(a_numVertices, 3);
-        Eigen::MatrixXi OF(a_numFaces, 3);
-
-        for (decltype(a_numVertices) i = 0; i < a_numVertices; i++)
-        {
-            auto& v = a_vertices[i];
-
-            OV.row(i) = Eigen::Vector3f(v.v.x(), v.v.y(), v.v.z());
-        }
-
-        for (decltype(a_numFaces) i = 0; i < a_numFaces; i++)
-        {
-            decltype(i) j = i * 3;
-
-            OF.row(i) = Eigen::Vector3i(a_indices[j], a_indices[j + 1], a_indices[j + 2]);
-        }
-
-        Eigen::MatrixXi SVI, SVJ;
-
-        igl::remove_duplicate_vertices(OV, OF, 1e-5, a_verticesOut, SVI, SVJ, a_indicesOut);
-    }
-
-    void IBoneCast::RemoveUnreferencedVertices(
-        const MeshPoint* a_vertices,
-        unsigned int a_numVertices,
-        const unsigned int* a_indices,
-        std::size_t a_numIndices,
-        std::shared_ptr<MeshPoint[]>& a_verticesOut,
-        unsigned int* a_indicesOut,
-        unsigned int& a_newVertexCount
-    )
-    {
-        struct iv_t
-        {
-            bool set;
-            unsigned int first;
-            unsigned int second;
-        };
-
-        auto im = std::make_unique<iv_t[]>(a_numVertices);
-
-        unsigned int numVertices(0);
-
-        for (decltype(a_numIndices) i = 0; i < a_numIndices; i++)
-        {
-            auto index = a_indices[i];
-
-            auto& e = im[index];
-
-            if (!e.set)
-            {
-                e.set = true;
-                e.first = numVertices;
-                e.second = index;
-
-                a_indicesOut[i] = numVertices;
-
-                numVertices++;
-            }
-            else
-            {
-                a_indicesOut[i] = e.first;
-            }
-        }
-
-        a_verticesOut = std::make_unique_for_overwrite<MeshPoint[]>(numVertices);
-
-        for (decltype(a_numVertices) i = 0; i < a_numVertices; i++)
-        {
-            auto& e = im[i];
-            if (e.set) {
-                a_verticesOut[e.first] = a_vertices[e.second];
-            }
-        }
-
-        a_newVertexCount = numVertices;
-
-    }
-
-
     bool IBoneCast::CreateColliderData(
         const ColliderDataStorage& a_cds,
         const unsigned int* a_indices,
         std::size_t a_numIndices,
         ColliderData* a_out,
-        bool& a_verticesShared,
-        bool a_removeVertices)
+        bool& a_verticesShared)
     {
-        std::shared_ptr<MeshPoint[]> rVertices;
-        std::unique_ptr<unsigned int[]> rIndices;
-        unsigned int numVertices;
-
-        if (a_removeVertices)
-        {
-            rIndices = std::make_unique_for_overwrite<unsigned int[]>(a_numIndices);
-
-            RemoveUnreferencedVertices(
-                a_cds.m_vertices.get(),
-                a_cds.m_numVertices,
-                a_indices,
-                a_numIndices,
-                rVertices,
-                rIndices.get(),
-                numVertices);
-
-            a_indices = rIndices.get();
-
-            a_verticesShared = false;
-        }
-        else
-        {
-            rVertices = a_cds.m_vertices;
-            numVertices = a_cds.m_numVertices;
+        if (a_numIndices < 3 || a_numIndices % 3 != 0) {
+            return false;
         }
 
-        Eigen::MatrixXf V;
-        Eigen::MatrixXi F;
+        auto indices = std::make_unique_for_overwrite<int[]>(a_numIndices);
+        std::unique_ptr<MeshPoint[]> vertices;
 
-        RemoveDuplicateVertices(
-            rVertices.get(),
-            static_cast<Eigen::Index>(numVertices),
+        auto numVertices = WeldVertices(
+            a_cds.m_vertices.get(),
+            a_cds.m_numVertices,
             a_indices,
-            static_cast<Eigen::Index>(a_numIndices / 3),
-            V,
-            F);
+            a_numIndices,
+            WELD_EPSILON,
+            vertices,
+            indices.get());
 
-        auto newVertices = V.rows();
-        auto newIndices = F.size();
-
-        if (newVertices == 0 || newIndices < 3 || newIndices % 3 != 0) {
+        if (numVertices == 0) {
             return false;
         }
 
-        if (newVertices == numVertices &&
-            newIndices == a_numIndices)
+        if (numVertices == a_cds.m_numVertices)
         {
-            a_out->m_indices = std::make_unique_for_overwrite<int[]>(a_numIndices);
-            a_out->m_hullPoints = std::make_unique_for_overwrite<MeshPoint[]>(a_numIndices);
-            a_out->m_vertices = rVertices;
-
-            for (decltype(a_numIndices) i = 0; i < a_numIndices; i++)
-            {
-                auto index = a_indices[i];
-
-                a_out->m_indices[i] = static_cast<int>(index);
-                a_out->m_hullPoints[i] = rVertices[index];
-            }
-
-            a_out->m_numTriangles = static_cast<int>(a_numIndices / 3);
-            a_out->m_numIndices = static_cast<int>(a_numIndices);
-            a_out->m_numVertices = static_cast<int>(numVertices);
+            // nothing was welded or dropped, keep the source buffer and indices
+            a_out->m_vertices = a_cds.m_vertices;
+            a_out->m_indices.Assign(a_indices, a_numIndices, numVertices);
         }
         else
         {
-
-            a_out->m_indices = std::make_unique_for_overwrite<int[]>(newIndices);
-            a_out->m_hullPoints = std::make_unique_for_overwrite<MeshPoint[]>(newIndices);
-            a_out->m_vertices = std::make_unique_for_overwrite<MeshPoint[]>(newVertices);
-
-            auto numRows = V.rows();
-
-            for (decltype(numRows) i = 0; i < numRows; i++)
-            {
-                auto row = V.row(i);
-                a_out->m_vertices[i] = MeshPoint(row.x(), row.y(), row.z());
-            }
-
-            numRows = F.rows();
-
-            for (decltype(numRows) i = 0; i < numRows; i++)
-            {
-                const auto row = F.row(i);
-
-                auto ia = row.x();
-                auto ib = row.y();
-                auto ic = row.z();
-
-                decltype(i) j = i * 3;
-
-                a_out->m_indices[j] = ia;
-                a_out->m_indices[j + 1] = ib;
-                a_out->m_indices[j + 2] = ic;
-
-                a_out->m_hullPoints[j] = a_out->m_vertices[ia];
-                a_out->m_hullPoints[j + 1] = a_out->m_vertices[ib];
-                a_out->m_hullPoints[j + 2] = a_out->m_vertices[ic];
-            }
-
-            a_out->m_numTriangles = static_cast<int>(newIndices / 3);
-            a_out->m_numIndices = static_cast<int>(newIndices);
-            a_out->m_numVertices = static_cast<int>(newVertices);
+            a_out->m_vertices = std::move(vertices);
+            a_out->m_indices.Assign(indices.get(), a_numIndices, numVertices);
 
             a_verticesShared = false;
-
         }
 
+        a_out->m_numTriangles = static_cast<int>(a_numIndices / 3);
+        a_out->m_numIndices = static_cast<int>(a_numIndices);
+        a_out->m_numVertices = static_cast<int>(numVertices);
+
         a_out->GenerateTriVertexArray();
 
+        const auto& driverConf = DCBP::GetDriverConfig();
+
+        a_out->GenerateHull(driverConf.convexHullMaxVertices);
+
         return true;
     }
 
@@ -530,76 +361,126 @@ namespace CBP
         return a_buffer;
     }
 
+    // stages are kept with the entry so a parameter change only reruns what depends on it
     bool IBoneCast::UpdateGeometry(
         ColliderDataStoragePair& a_in,
         float a_weightThreshold,
         float a_simplifyTarget,
         float a_simplifyTargetError)
     {
+        auto& stages = a_in.stages;
+
         if (!a_in.first.m_numVertices) {
             return false;
         }
 
-        auto numIndices = a_in.first.m_indices.size();
-        if (numIndices < 3) {
+        if (a_in.first.m_indices.size() < 3) {
             return false;
         }
 
-        auto startingIndices = numIndices;
+        if (!stages.filtered ||
+            stages.weightThreshold != a_weightThreshold)
+        {
+            stages.filteredIndices.clear();
+
+            static_cast<void>(FilterIndicesByWeight(a_in, stages.filteredIndices, a_weightThreshold));
 
-        auto ibuffer = decltype(ColliderDataStorage::m_indices)();
+            stages.filteredIndices.shrink_to_fit();
+            stages.weightThreshold = a_weightThreshold;
+            stages.filtered = true;
+            stages.simplified = false;
+            stages.built = false;
+        }
 
-        auto& indices = FilterIndicesByWeight(a_in, ibuffer, a_weightThreshold);
+        const auto& indices = a_weightThreshold > 0.0f ?
+            stages.filteredIndices :
+            a_in.first.m_indices;
 
-        numIndices = indices.size();
+        auto numIndices = indices.size();
         if (numIndices < 3) {
             return false;
         }
 
-        bool verticesShared(true);
-
-        auto data = std::make_unique<ColliderData>();
-
-        auto targetIndices = static_cast<std::size_t>(static_cast<long double>(numIndices) * long double(a_simplifyTarget));
+        if (!stages.simplified ||
+            stages.simplifyTarget != a_simplifyTarget ||
+            stages.simplifyTargetError != a_simplifyTargetError)
+        {
+            auto targetIndices = static_cast<std::size_t>(static_cast<long double>(numIndices) * long double(a_simplifyTarget));
 
-        bool result;
+            if (targetIndices < numIndices)
+            {
+                targetIndices = std::clamp<std::size_t>(targetIndices - (targetIndices % 3), 3, numIndices);
+
+                decltype(stages.simplifiedIndices) tmp(numIndices);
+
+                auto numSimplified = ::meshopt_simplify(
+                    tmp.data(),
+                    indices.data(),
+                    numIndices,
+                    *a_in.first.m_vertices.get(),
+                    a_in.first.m_numVertices,
+                    sizeof(decltype(a_in.first.m_vertices)::element_type::v),
+                    targetIndices,
+                    a_simplifyTargetError);
+
+                if (numSimplified % 3 != 0) {
+                    stages.simplified = false;
+                    stages.built = false;
+                    return false;
+                }
 
-        if (targetIndices < numIndices)
-        {
-            targetIndices = std::clamp<std::size_t>(targetIndices - (targetIndices % 3), 3, numIndices);
+                tmp.resize(numSimplified);
+                tmp.shrink_to_fit();
 
-            auto tmp = std::make_unique_for_overwrite<unsigned int[]>(numIndices);
+                // the error slider often doesn't change the output
+                if (!stages.simplified ||
+                    !stages.simplifyApplied ||
+                    tmp != stages.simplifiedIndices)
+                {
+                    stages.built = false;
+                }
 
-            numIndices = ::meshopt_simplify(
-                tmp.get(),
-                indices.data(),
-                numIndices,
-                *a_in.first.m_vertices.get(),
-                a_in.first.m_numVertices,
-                sizeof(decltype(a_in.first.m_vertices)::element_type::v),
-                targetIndices,
-                a_simplifyTargetError);
+                stages.simplifiedIndices = std::move(tmp);
+                stages.simplifyApplied = true;
+            }
+            else
+            {
+                if (!stages.simplified || stages.simplifyApplied) {
+                    stages.built = false;
+                }
 
-            if (numIndices % 3 != 0) {
-                return false;
+                stages.simplifiedIndices.clear();
+                stages.simplifiedIndices.shrink_to_fit();
+                stages.simplifyApplied = false;
             }
 
-            result = CreateColliderData(a_in.first, tmp.get(), numIndices, data.get(), verticesShared, numIndices != startingIndices);
+            stages.simplifyTarget = a_simplifyTarget;
+            stages.simplifyTargetError = a_simplifyTargetError;
+            stages.simplified = true;
         }
-        else
-        {
-            result = CreateColliderData(a_in.first, indices.data(), numIndices, data.get(), verticesShared, numIndices != startingIndices);
+
+        if (stages.built && a_in.second->m_numIndices) {
+            return true;
         }
 
-        if (!result) {
+        const auto& output = stages.simplifyApplied ?
+            stages.simplifiedIndices :
+            indices;
+
+        bool verticesShared(true);
+
+        auto data = std::make_unique<ColliderData>();
+
+        if (!CreateColliderData(a_in.first, output.data(), output.size(), data.get(), verticesShared)) {
             return false;
         }
 
         a_in.second = std::move(data);
         a_in.SetVerticesShared(verticesShared);
 
-        return true;
+        stages.built = true;
 
+        return true;
     }
 
     bool IBoneCast::GetGeometry(
@@ -743,8 +624,6 @@ namespace CBP
 
         auto sex = Game::GetActorSex(a_actor);
 
-        Util::Model::ModelLoader modelLoader;
-
         for (auto arma : skin->armorAddons)
         {
             if (!arma) {
@@ -757,11 +636,20 @@ namespace CBP
                 continue;
             }
 
-            if (!modelLoader.Load(name)) {
+            switch (ISkinModelCache::GetGeometry(name, a_nodeName, a_shape, a_result))
+            {
+            case ISkinModelCache::LookupResult::kFound:
+                return true;
+            case ISkinModelCache::LookupResult::kNotFound:
+                continue;
+            }
+
+            auto model = ISkinModelCache::GetModel(name);
+            if (!model) {
                 continue;
             }
 
-            auto& stream = modelLoader.GetStream();
+            auto& stream = model->GetStream();
 
             for (auto e : stream->m_rootObjects)
             {
@@ -787,9 +675,12 @@ namespace CBP
                     }
                 )) 
                 {
+                    ISkinModelCache::AddGeometry(name, a_nodeName, a_shape, std::addressof(a_result));
                     return true;
                 }
             }
+
+            ISkinModelCache::AddGeometry(name, a_nodeName, a_shape, nullptr);
         }
 
         return false;
@@ -798,10 +689,14 @@ namespace CBP
 
     BoneCastCache::BoneCastCache(
         IBoneCastIO& a_iio,
-        std::size_t a_maxSize)
+        std::size_t a_maxSize,
+        std::size_t a_maxColdSize)
         :
         m_maxSize(a_maxSize),
         m_totalSize(0),
+        m_maxColdSize(a_maxColdSize),
+        m_coldSize(0),
+        m_stats{ 0 },
         m_iio(a_iio)
     {
     }
@@ -816,15 +711,21 @@ namespace CBP
 
         auto key = std::make_pair(a_handle, a_nodeName);
 
+        if (auto itc = m_cold.find(key); itc != m_cold.end()) {
+            RemoveCold(itc);
+        }
+
         iterator it = m_data.find(key);
 
         if (it != m_data.end()) {
             m_totalSize -= it->second.m_size;
             it->second.m_data = std::forward<T>(a_data);
-            it->second.m_lastAccess = IPerfCounter::Query();
+            Touch(it->second);
         }
         else {
+            m_lru.emplace_front(key);
             it = m_data.try_emplace(std::move(key), std::forward<T>(a_data)).first;
+            it->second.m_lru = m_lru.begin();
         }
 
         it->second.m_size = it->second.m_data.UpdateSize();
@@ -845,34 +746,156 @@ namespace CBP
         Game::VMHandle a_handle,
         const stl::fixed_string& a_nodeName)
     {
-        auto it = m_data.find(std::make_pair(a_handle, a_nodeName));
+        auto key = std::make_pair(a_handle, a_nodeName);
+
+        bool result(false);
+
+        if (auto itc = m_cold.find(key); itc != m_cold.end())
+        {
+            RemoveCold(itc);
+            result = true;
+        }
+
+        auto it = m_data.find(key);
         if (it == m_data.end())
-            return false;
+            return result;
 
         Remove(it);
 
         return true;
     }
 
+    bool BoneCastCache::Contains(
+        Game::VMHandle a_handle,
+        const stl::fixed_string& a_nodeName) const
+    {
+        auto key = std::make_pair(a_handle, a_nodeName);
+
+        return m_data.contains(key) || m_cold.contains(key);
+    }
+
     template <class T, BoneCastCache::is_iterator_type<T>>
     void BoneCastCache::Remove(
         const T& a_it)
     {
         std::size_t size = a_it->second.m_size;
+        m_lru.erase(a_it->second.m_lru);
         m_data.erase(a_it);
         m_totalSize -= size;
     }
 
+    void BoneCastCache::RemoveCold(const cold_storage_t::iterator& a_it)
+    {
+        m_coldSize -= a_it->second.m_data.size();
+        m_coldLru.erase(a_it->second.m_lru);
+        m_cold.erase(a_it);
+    }
+
+    void BoneCastCache::Demote(const iterator& a_it)
+    {
+        try
+        {
+            std::string buffer;
+
+            {
+                using namespace boost::iostreams;
+                using namespace boost::archive;
+
+                filtering_ostream out;
+                out.push(gzip_compressor(gzip_params(zlib::best_speed)));
+                out.push(back_inserter(buffer));
+
+                binary_oarchive oa(out);
+
+                oa << a_it->second.m_data;
+            }
+
+            buffer.shrink_to_fit();
+
+            auto size = buffer.size();
+
+            if (size <= m_maxColdSize)
+            {
+                while (!m_coldLru.empty() && m_coldSize + size > m_maxColdSize)
+                {
+                    RemoveCold(m_cold.find(m_coldLru.back()));
+                    m_stats.coldEvictions++;
+                }
+
+                m_coldLru.emplace_front(a_it->first);
+
+                m_cold.insert_or_assign(a_it->first, ColdEntry{
+                    std::move(buffer),
+                    a_it->second.m_data.contentKey,
+                    m_coldLru.begin() });
+
+                m_coldSize += size;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            m_iio.Error("%s: [%.8X] [%s]: %s",
+                __FUNCTION__,
+                a_it->first.first.GetFormID().get(),
+                a_it->first.second.c_str(),
+                e.what());
+        }
+
+        Remove(a_it);
+
+        m_stats.evictions++;
+    }
+
+    bool BoneCastCache::Promote(const key_t& a_key, iterator& a_out)
+    {
+        auto itc = m_cold.find(a_key);
+        if (itc == m_cold.end())
+            return false;
+
+        ColliderDataStoragePair entry;
+
+        try
+        {
+            using namespace boost::iostreams;
+            using namespace boost::archive;
+
+            auto& buffer = itc->second.m_data;
+
+            filtering_istream in;
+            in.push(gzip_decompressor());
+            in.push(array_source(buffer.data(), buffer.size()));
+
+            binary_iarchive ia(in);
+
+            ia >> entry;
+        }
+        catch (const std::exception& e)
+        {
+            m_iio.Error("%s: [%.8X] [%s]: %s",
+                __FUNCTION__,
+                a_key.first.GetFormID().get(),
+                a_key.second.c_str(),
+                e.what());
+
+            RemoveCold(itc);
+
+            return false;
+        }
+
+        entry.contentKey = std::move(itc->second.m_contentKey);
+
+        RemoveCold(itc);
+
+        a_out = Add(a_key.first, a_key.second, std::move(entry));
+
+        return true;
+    }
+
     void BoneCastCache::EvictOverflow()
     {
         while (m_data.size() > 1 && m_totalSize > m_maxSize)
         {
-            auto it = std::min_element(m_data.begin(), m_data.end(),
-                [](auto& a, auto& b) {
-                    return a.second.m_lastAccess < b.second.m_lastAccess;
-                });
-
-            Remove(it);
+            Demote(m_data.find(m_lru.back()));
         }
     }
 
@@ -883,14 +906,27 @@ namespace CBP
         bool a_read,
         T& a_result)
     {
-        auto it = m_data.find(std::make_pair(a_handle, a_nodeName));
+        auto key = std::make_pair(a_handle, a_nodeName);
+
+        auto it = m_data.find(key);
         if (it != m_data.end())
         {
-            it->second.m_lastAccess = IPerfCounter::Query();
+            Touch(it->second);
             a_result = std::move(it);
+            m_stats.hits++;
+            return true;
+        }
+
+        iterator itp;
+        if (Promote(key, itp))
+        {
+            a_result = std::move(itp);
+            m_stats.coldHits++;
             return true;
         }
 
+        m_stats.misses++;
+
         if (!a_read)
             return false;
 
@@ -956,11 +992,22 @@ namespace CBP
 
         if (a_result->second.m_data != a_nodeConfig) {
 
-            bool res = UpdateGeometry(
-                a_result->second.m_data,
-                a_nodeConfig.fp.f32.bcWeightThreshold,
-                a_nodeConfig.fp.f32.bcSimplifyTarget,
-                a_nodeConfig.fp.f32.bcSimplifyTargetError);
+            auto& data = a_result->second.m_data;
+
+            auto weightThreshold = a_nodeConfig.fp.f32.bcWeightThreshold;
+            auto simplifyTarget = a_nodeConfig.fp.f32.bcSimplifyTarget;
+            auto simplifyTargetError = a_nodeConfig.fp.f32.bcSimplifyTargetError;
+
+            bool res = GetShared(data, weightThreshold, simplifyTarget, simplifyTargetError);
+
+            if (!res)
+            {
+                res = UpdateGeometry(data, weightThreshold, simplifyTarget, simplifyTargetError);
+
+                if (res) {
+                    AddShared(data, weightThreshold, simplifyTarget, simplifyTargetError);
+                }
+            }
 
             if (!res) {
                 a_result->second.m_data.second =
@@ -994,9 +1041,479 @@ namespace CBP
         return true;
     }
 
-    bool IBoneCast::Update(
-        Game::VMHandle a_handle,
-        const stl::fixed_string& a_nodeName,
+    bool IBoneCast::IsAsync()
+    {
+        return DCBP::GetDriverConfig().boneCastWorkerThreads > 0;
+    }
+
+    bool IBoneCast::GetAsync(
+        Game::VMHandle a_handle,
+        const stl::fixed_string& a_nodeName,
+        const configNode_t& a_nodeConfig,
+        BoneResult& a_out,
+        bool& a_pending)
+    {
+        auto& cache = GetCache();
+
+        BoneCastCache::iterator result;
+
+        bool found = cache.Get(a_handle, a_nodeName, false, result);
+
+        if (found && result->second.m_data == a_nodeConfig)
+        {
+            a_pending = false;
+            return ProcessResult(result, a_nodeConfig, a_out);
+        }
+
+        // another actor already has this geometry processed with the same parameters
+        if (found && GetShared(
+            result->second.m_data,
+            a_nodeConfig.fp.f32.bcWeightThreshold,
+            a_nodeConfig.fp.f32.bcSimplifyTarget,
+            a_nodeConfig.fp.f32.bcSimplifyTargetError))
+        {
+            cache.UpdateSize(result->second);
+
+            result->second.m_updateID.Update();
+            result->second.m_data = a_nodeConfig;
+
+            a_pending = false;
+            return ProcessResult(result, a_nodeConfig, a_out);
+        }
+
+        a_pending = true;
+
+        auto key = std::make_pair(a_handle, a_nodeName);
+
+        if (!m_Instance.m_pending.emplace(key).second) {
+            return false;
+        }
+
+        PushAsyncJob(
+            std::move(key),
+            a_nodeConfig,
+            found ? std::addressof(result->second.m_data) : nullptr);
+
+        return false;
+    }
+
+    void IBoneCast::PushAsyncJob(
+        bonecast_cache_key_t&& a_key,
+        const configNode_t& a_nodeConfig,
+        const ColliderDataStoragePair* a_source)
+    {
+        auto job = std::make_unique<asyncJob_t>();
+
+        job->key = std::move(a_key);
+        job->weightThreshold = a_nodeConfig.fp.f32.bcWeightThreshold;
+        job->simplifyTarget = a_nodeConfig.fp.f32.bcSimplifyTarget;
+        job->simplifyTargetError = a_nodeConfig.fp.f32.bcSimplifyTargetError;
+        job->generation = m_Instance.m_generation;
+        job->result = false;
+
+        if (a_source)
+        {
+            // carries the stage results along
+            job->data = *a_source;
+            job->source = a_source->first.m_vertices.get();
+            job->read = false;
+        }
+        else
+        {
+            job->source = nullptr;
+            job->read = true;
+        }
+
+        job->data = a_nodeConfig;
+
+        m_Instance.m_worker.Push(std::move(job));
+    }
+
+    void IBoneCast::QueuePrefetch(
+        Game::VMHandle a_handle,
+        PrefetchPriority a_priority)
+    {
+        if (!IsAsync() || DCBP::GetDriverConfig().boneCastPrefetchBudget <= 0)
+            return;
+
+        auto priority = static_cast<std::uint32_t>(a_priority);
+
+        std::lock_guard<std::mutex> lock(m_Instance.m_prefetchLock);
+
+        auto r = m_Instance.m_prefetchQueued.try_emplace(a_handle, priority);
+        if (!r.second)
+        {
+            if (r.first->second >= priority)
+                return;
+
+            // the old request is skipped when popped
+            r.first->second = priority;
+        }
+
+        m_Instance.m_prefetchQueue.emplace(prefetchRequest_t{
+            a_handle,
+            priority,
+            m_Instance.m_prefetchSeq++ });
+    }
+
+    bool IBoneCast::PopPrefetch(prefetchRequest_t& a_out)
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchLock);
+
+        while (!m_prefetchQueue.empty())
+        {
+            auto e = m_prefetchQueue.top();
+            m_prefetchQueue.pop();
+
+            auto it = m_prefetchQueued.find(e.handle);
+            if (it == m_prefetchQueued.end() || it->second != e.priority)
+                continue;
+
+            m_prefetchQueued.erase(it);
+
+            a_out = e;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // keeps the original sequence number so the actor stays ahead of newer requests
+    void IBoneCast::RequeuePrefetch(const prefetchRequest_t& a_request)
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchLock);
+
+        auto r = m_prefetchQueued.try_emplace(a_request.handle, a_request.priority);
+        if (!r.second)
+        {
+            if (r.first->second >= a_request.priority)
+                return;
+
+            r.first->second = a_request.priority;
+        }
+
+        m_prefetchQueue.emplace(a_request);
+    }
+
+    void IBoneCast::ClearPrefetch()
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchLock);
+
+        m_prefetchQueue = decltype(m_prefetchQueue)();
+        m_prefetchQueued.clear();
+    }
+
+    void IBoneCast::ProcessPrefetch()
+    {
+        auto budget = DCBP::GetDriverConfig().boneCastPrefetchBudget;
+
+        if (!IsAsync() || budget <= 0)
+            return;
+
+        auto& cache = GetCache();
+        auto& pending = m_Instance.m_pending;
+
+        int issued = 0;
+
+        while (issued < budget && pending.size() < PREFETCH_MAX_PENDING)
+        {
+            prefetchRequest_t request;
+            if (!m_Instance.PopPrefetch(request))
+                break;
+
+            auto handle = request.handle;
+
+            auto actor = handle.Resolve<Actor>();
+            if (!actor)
+                continue;
+
+            auto& nodeConfig = IConfig::GetActorNode(handle,
+                Game::GetActorSex(actor) == 0 ? ConfigGender::Male : ConfigGender::Female);
+
+            for (auto& e : nodeConfig)
+            {
+                // out of budget, the remaining nodes are issued on a later call
+                if (issued >= budget || pending.size() >= PREFETCH_MAX_PENDING)
+                {
+                    m_Instance.RequeuePrefetch(request);
+                    break;
+                }
+
+                if (!e.second.bl.b.boneCast)
+                    continue;
+
+                if (cache.Contains(handle, e.first))
+                    continue;
+
+                auto key = std::make_pair(handle, e.first);
+
+                if (pending.contains(key))
+                    continue;
+
+                // no data was ever sampled for this node
+                if (!m_Instance.m_iio.Exists(handle, e.first))
+                    continue;
+
+                pending.emplace(key);
+
+                PushAsyncJob(std::move(key), e.second, nullptr);
+
+                issued++;
+            }
+        }
+    }
+
+    void IBoneCast::ProcessAsyncJob(asyncJob_t& a_job)
+    {
+        if (a_job.read)
+        {
+            IBoneCastIO iio;
+
+            if (!iio.Read(a_job.key.first, a_job.key.second, a_job.data))
+            {
+                a_job.error = "read failed: ";
+                a_job.error += iio.GetLastException().what();
+
+                return;
+            }
+        }
+
+        bool res = UpdateGeometry(
+            a_job.data,
+            a_job.weightThreshold,
+            a_job.simplifyTarget,
+            a_job.simplifyTargetError);
+
+        if (!res) {
+            a_job.data.second = std::make_unique<ColliderData>();
+        }
+
+        a_job.result = true;
+    }
+
+    void IBoneCast::ProcessCompleted()
+    {
+        std::vector<std::unique_ptr<asyncJob_t>> completed;
+
+        m_Instance.m_worker.GetCompleted(completed);
+
+        auto& cache = GetCache();
+
+        for (auto& e : completed)
+        {
+            if (!e->error.empty())
+            {
+                m_Instance.m_iio.Error("%s: [%.8X] [%s]: %s",
+                    __FUNCTION__,
+                    e->key.first.GetFormID().get(),
+                    e->key.second.c_str(),
+                    e->error.c_str());
+            }
+
+            // the pending set was cleared with the cache, a newer job may own the key
+            if (e->generation != m_Instance.m_generation) {
+                continue;
+            }
+
+            auto& key = e->key;
+
+            m_Instance.m_pending.erase(key);
+
+            if (!e->result) {
+                continue;
+            }
+
+            // source geometry was resampled while the update was running
+            BoneCastCache::iterator current;
+            if (cache.Get(key.first, key.second, false, current) &&
+                current->second.m_data.first.m_vertices.get() != e->source)
+            {
+                continue;
+            }
+
+            auto it = cache.Add(key.first, key.second, std::move(e->data));
+            it->second.m_updateID.Update();
+
+            AddShared(
+                it->second.m_data,
+                e->weightThreshold,
+                e->simplifyTarget,
+                e->simplifyTargetError);
+
+            DCBP::DispatchActorTask(key.first, ControllerInstruction::Action::UpdateConfig);
+        }
+    }
+
+    bool IBoneCast::MakeSharedKey(
+        const ColliderDataStoragePair& a_in,
+        float a_weightThreshold,
+        float a_simplifyTarget,
+        float a_simplifyTargetError,
+        std::string& a_out)
+    {
+        if (a_in.contentKey.empty())
+            return false;
+
+        char buf[160];
+
+        _snprintf_s(buf, _TRUNCATE, "%s.%a.%a.%a",
+            a_in.contentKey.c_str(),
+            a_weightThreshold,
+            a_simplifyTarget,
+            a_simplifyTargetError);
+
+        a_out = buf;
+
+        return true;
+    }
+
+    bool IBoneCast::GetShared(
+        ColliderDataStoragePair& a_in,
+        float a_weightThreshold,
+        float a_simplifyTarget,
+        float a_simplifyTargetError)
+    {
+        std::string key;
+        if (!MakeSharedKey(a_in, a_weightThreshold, a_simplifyTarget, a_simplifyTargetError, key))
+            return false;
+
+        auto& shared = m_Instance.m_shared;
+
+        auto it = shared.find(key);
+        if (it == shared.end())
+            return false;
+
+        auto data = it->second.lock();
+        if (!data)
+        {
+            shared.erase(it);
+            return false;
+        }
+
+        a_in.SetVerticesShared(data->m_vertices.get() == a_in.first.m_vertices.get());
+        a_in.second = std::move(data);
+        a_in.stages.built = false;
+
+        return true;
+    }
+
+    void IBoneCast::AddShared(
+        const ColliderDataStoragePair& a_in,
+        float a_weightThreshold,
+        float a_simplifyTarget,
+        float a_simplifyTargetError)
+    {
+        if (!a_in.second->m_numIndices)
+            return;
+
+        std::string key;
+        if (!MakeSharedKey(a_in, a_weightThreshold, a_simplifyTarget, a_simplifyTargetError, key))
+            return;
+
+        auto& shared = m_Instance.m_shared;
+
+        std::erase_if(shared, [](const auto& a_v) { return a_v.second.expired(); });
+
+        shared.insert_or_assign(std::move(key), a_in.second);
+    }
+
+    IBoneCast::AsyncWorker::~AsyncWorker() noexcept
+    {
+        Shutdown();
+    }
+
+    void IBoneCast::AsyncWorker::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_cond.notify_all();
+
+        for (auto& e : m_threads)
+        {
+            if (e.joinable()) {
+                e.join();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_threads.clear();
+        m_queue = decltype(m_queue)();
+        m_completed.clear();
+    }
+
+    void IBoneCast::AsyncWorker::Push(std::unique_ptr<asyncJob_t>&& a_job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stop) {
+                return;
+            }
+
+            if (m_threads.empty())
+            {
+                auto numThreads = std::max(DCBP::GetDriverConfig().boneCastWorkerThreads, 1);
+
+                for (int i = 0; i < numThreads; i++) {
+                    m_threads.emplace_back(&AsyncWorker::Run, this);
+                }
+            }
+
+            m_queue.emplace(std::move(a_job));
+        }
+
+        m_cond.notify_one();
+    }
+
+    void IBoneCast::AsyncWorker::GetCompleted(std::vector<std::unique_ptr<asyncJob_t>>& a_out)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        a_out.swap(m_completed);
+    }
+
+    void IBoneCast::AsyncWorker::Run()
+    {
+        for (;;)
+        {
+            std::unique_ptr<asyncJob_t> job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_cond.wait(lock, [this] {
+                    return m_stop || !m_queue.empty(); });
+
+                if (m_stop) {
+                    return;
+                }
+
+                job = std::move(m_queue.front());
+                m_queue.pop();
+            }
+
+            try
+            {
+                ProcessAsyncJob(*job);
+            }
+            catch (const std::exception& e)
+            {
+                job->error = e.what();
+                job->result = false;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completed.emplace_back(std::move(job));
+        }
+    }
+
+    bool IBoneCast::Update(
+        Game::VMHandle a_handle,
+        const stl::fixed_string& a_nodeName,
         const configNode_t& a_nodeConfig)
     {
         auto actor = a_handle.Resolve<Actor>();
@@ -1037,6 +1554,8 @@ namespace CBP
             }
         }
 
+        IBoneCastIO::MakeContentKey(cacheEntry.first, cacheEntry.contentKey);
+
         auto& cache = GetCache();
         auto r = cache.Add(a_handle, a_nodeName, std::move(cacheEntry));
 
@@ -1064,29 +1583,13 @@ namespace CBP
     {
         try
         {
-            auto& driverConf = DCBP::GetDriverConfig();
-
             std::string key;
             MakeKey(a_handle, a_nodeName, key);
 
-            auto path = driverConf.paths.boneCastData / key;
-
-            std::ifstream ifs;
-
-            ifs.open(path, std::ifstream::in | std::ifstream::binary);
-            if (!ifs.is_open())
-                throw std::system_error(errno, std::system_category(), path.string());
+            if (!BoneCastStore::GetSingleton().Read(key, a_out.first, a_out.contentKey))
+                throw std::exception("Not found");
 
-            using namespace boost::iostreams;
-            using namespace boost::archive;
-
-            filtering_streambuf<input> in;
-            in.push(gzip_decompressor(zlib::default_window_bits, 1024 * 256));
-            in.push(ifs);
-
-            binary_iarchive ia(in);
-
-            ia >> a_out;
+            a_out.UpdateSize();
 
             return true;
         }
@@ -1104,51 +1607,19 @@ namespace CBP
     {
         try
         {
-            auto& driverConf = DCBP::GetDriverConfig();
-
             std::string key;
             MakeKey(a_handle, a_nodeName, key);
 
-            auto path = driverConf.paths.boneCastData / key;
-
-            Serialization::CreateRootPath(path);
-
-            auto tmpPath(path);
-            tmpPath += ".tmp";
-
-            try
+            if (a_in.contentKey.empty())
             {
-                {
-                    std::ofstream ofs;
-
-                    ofs.open(
-                        tmpPath,
-                        std::ofstream::out |
-                        std::ofstream::binary |
-                        std::ofstream::trunc,
-                        _SH_DENYWR);
-
-                    if (!ofs.is_open())
-                        throw std::system_error(errno, std::system_category(), tmpPath.string());
-
-                    using namespace boost::iostreams;
-                    using namespace boost::archive;
-
-                    filtering_streambuf<output> out;
-                    out.push(gzip_compressor(gzip_params(zlib::best_speed), 1024 * 256));
-                    out.push(ofs);
-
-                    binary_oarchive oa(out);
-
-                    oa << a_in;
-                }
+                std::string contentKey;
+                MakeContentKey(a_in.first, contentKey);
 
-                fs::rename(tmpPath, path);
+                BoneCastStore::GetSingleton().Write(key, contentKey, a_in.first);
             }
-            catch (const std::exception& e)
+            else
             {
-                Serialization::SafeCleanup(tmpPath);
-                throw e;
+                BoneCastStore::GetSingleton().Write(key, a_in.contentKey, a_in.first);
             }
 
             return true;
@@ -1160,6 +1631,47 @@ namespace CBP
         }
     }
 
+    bool IBoneCastIO::Exists(
+        Game::VMHandle a_handle,
+        const stl::fixed_string& a_nodeName)
+    {
+        try
+        {
+            std::string key;
+            MakeKey(a_handle, a_nodeName, key);
+
+            return BoneCastStore::GetSingleton().Contains(key);
+        }
+        catch (const std::exception& e)
+        {
+            m_lastException = e;
+            return false;
+        }
+    }
+
+    void IBoneCastIO::MakeContentKey(
+        const ColliderDataStorage& a_in,
+        std::string& a_out)
+    {
+        std::string s;
+        s.reserve(
+            sizeof(float) * 3 * a_in.m_numVertices +
+            sizeof(float) * a_in.m_weights.size() +
+            sizeof(unsigned int) * a_in.m_indices.size() +
+            sizeof(a_in.m_numTriangles));
+
+        // w is padding and not guaranteed to be zero
+        for (decltype(a_in.m_numVertices) i = 0; i < a_in.m_numVertices; i++) {
+            s.append(reinterpret_cast<const char*>(a_in.m_vertices[i].v.m_floats), sizeof(float) * 3);
+        }
+
+        s.append(reinterpret_cast<const char*>(a_in.m_weights.data()), sizeof(float) * a_in.m_weights.size());
+        s.append(reinterpret_cast<const char*>(a_in.m_indices.data()), sizeof(unsigned int) * a_in.m_indices.size());
+        s.append(reinterpret_cast<const char*>(std::addressof(a_in.m_numTriangles)), sizeof(a_in.m_numTriangles));
+
+        Crypto::SHA1(s, a_out);
+    }
+
     const pluginInfo_t* IBoneCastIO::GetPluginInfo(
         Game::FormID a_formid) const
     {
@@ -58,6 +58,9 @@ namespace CBP
     {
     public:
 
+        using key_t = bonecast_cache_key_t;
+        using lru_list_t = std::list<key_t>;
+
         struct CacheEntry
         {
             CacheEntry() = delete;
@@ -67,8 +70,7 @@ namespace CBP
                 const T& a_data)
                 :
                 m_size(0),
-                m_data(a_data),
-                m_lastAccess(IPerfCounter::Query())
+                m_data(a_data)
             {
             }
 
@@ -77,22 +79,38 @@ namespace CBP
                 T&& a_data)
                 :
                 m_size(0),
-                m_data(std::move(a_data)),
-                m_lastAccess(IPerfCounter::Query())
+                m_data(std::move(a_data))
             {
             }
 
             ColliderDataStoragePair m_data;
 
             std::size_t m_size;
-            long long m_lastAccess;
+            lru_list_t::iterator m_lru;
             BoneCacheUpdateID m_updateID;
         };
 
+        // evicted entries, source geometry only, compressed
+        struct ColdEntry
+        {
+            std::string m_data;
+            std::string m_contentKey;
+            lru_list_t::iterator m_lru;
+        };
+
+        struct Stats
+        {
+            std::uint64_t hits;
+            std::uint64_t coldHits;
+            std::uint64_t misses;
+            std::uint64_t evictions;
+            std::uint64_t coldEvictions;
+        };
+
     public:
 
-        using key_t = bonecast_cache_key_t;
         using data_storage_t = std::unordered_map<key_t, CacheEntry>;
+        using cold_storage_t = std::unordered_map<key_t, ColdEntry>;
 
         using iterator = data_storage_t::iterator;
         using const_iterator = data_storage_t::const_iterator;
@@ -111,7 +129,7 @@ namespace CBP
     public:
 
         BoneCastCache() = delete;
-        BoneCastCache(IBoneCastIO& a_iio, std::size_t a_maxSize);
+        BoneCastCache(IBoneCastIO& a_iio, std::size_t a_maxSize, std::size_t a_maxColdSize);
 
         BoneCastCache(const BoneCastCache&) = delete;
         BoneCastCache(BoneCastCache&&) = delete;
@@ -135,6 +153,11 @@ namespace CBP
             Game::VMHandle a_actor,
             const stl::fixed_string& a_nodeName);
 
+        // hot or cold, doesn't promote
+        [[nodiscard]] bool Contains(
+            Game::VMHandle a_actor,
+            const stl::fixed_string& a_nodeName) const;
+
         template <class T, is_iterator_type<T> = 0>
         void Remove(const T& a_it);
 
@@ -145,19 +168,56 @@ namespace CBP
         SKMP_FORCEINLINE void Release()
         {
             m_data.swap(decltype(m_data)());
+            m_cold.swap(decltype(m_cold)());
+            m_lru.clear();
+            m_coldLru.clear();
             m_totalSize = 0;
+            m_coldSize = 0;
         }
 
         [[nodiscard]] SKMP_FORCEINLINE auto GetSize() const noexcept {
             return m_totalSize;
         }
 
+        [[nodiscard]] SKMP_FORCEINLINE auto GetColdSize() const noexcept {
+            return m_coldSize;
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE auto GetNumEntries() const noexcept {
+            return m_data.size();
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE auto GetNumColdEntries() const noexcept {
+            return m_cold.size();
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE const auto& GetStats() const noexcept {
+            return m_stats;
+        }
+
     private:
 
+        SKMP_FORCEINLINE void Touch(CacheEntry& a_entry) {
+            m_lru.splice(m_lru.begin(), m_lru, a_entry.m_lru);
+        }
+
+        void Demote(const iterator& a_it);
+        [[nodiscard]] bool Promote(const key_t& a_key, iterator& a_out);
+        void RemoveCold(const cold_storage_t::iterator& a_it);
+
         data_storage_t m_data;
+        cold_storage_t m_cold;
+
+        // most recently used first
+        lru_list_t m_lru;
+        lru_list_t m_coldLru;
 
         std::size_t m_maxSize;
         std::size_t m_totalSize;
+        std::size_t m_maxColdSize;
+        std::size_t m_coldSize;
+
+        Stats m_stats;
 
         IBoneCastIO& m_iio;
 
@@ -178,6 +238,16 @@ namespace CBP
             const stl::fixed_string& a_nodeName,
             const ColliderDataStoragePair& a_in);
 
+        // index lookup only, doesn't touch record data
+        [[nodiscard]] bool Exists(
+            Game::VMHandle a_handle,
+            const stl::fixed_string& a_nodeName);
+
+        // equal source geometry yields the same key regardless of actor
+        static void MakeContentKey(
+            const ColliderDataStorage& a_in,
+            std::string& a_out);
+
         /*[[nodiscard]] SKMP_FORCEINLINE auto GetLock() const {
             return std::addressof(m_rwLock);
         }*/
@@ -207,33 +277,87 @@ namespace CBP
     {
         friend class BoneCastCreateTask;
 
-        struct Triangle
+        static constexpr float WELD_EPSILON = 1e-5f;
+
+        // reused between extractions, sized by the source vertex count
+        struct extractScratch_t
         {
-            std::uint32_t m_indices[3];
-            bool m_isBoneTri;
+            std::vector<float> weights;
+            std::vector<std::uint8_t> boneVertex;
+            std::vector<std::uint32_t> remap;
+            std::vector<MeshPoint> vertices;
+            std::vector<unsigned int> indices;
         };
 
-        struct SKMP_ALIGN_AUTO Vertex
+        struct asyncJob_t
         {
-            SKMP_DECLARE_ALIGNED_ALLOCATOR_AUTO();
+            bonecast_cache_key_t key;
+            ColliderDataStoragePair data;
+            const MeshPoint* source;
 
-            SKMP_FORCEINLINE Vertex() :
-                m_weight(-1.0f),
-                m_index(0),
-                m_hasVertex(false)
+            float weightThreshold;
+            float simplifyTarget;
+            float simplifyTargetError;
+
+            std::uint32_t generation;
+
+            // logged from ProcessCompleted, workers don't log
+            std::string error;
+
+            bool read;
+            bool result;
+        };
+
+        struct prefetchRequest_t
+        {
+            Game::VMHandle handle;
+            std::uint32_t priority;
+            std::uint64_t seq;
+
+            // higher priority first, FIFO within a priority
+            SKMP_FORCEINLINE bool operator<(const prefetchRequest_t& a_rhs) const
             {
-                m_triangles.reserve(40);
+                return priority != a_rhs.priority ?
+                    priority < a_rhs.priority :
+                    seq > a_rhs.seq;
             }
+        };
+
+        static constexpr std::size_t PREFETCH_MAX_PENDING = 32;
+
+        class AsyncWorker
+        {
+        public:
+            AsyncWorker() = default;
+            ~AsyncWorker() noexcept;
+
+            void Push(std::unique_ptr<asyncJob_t>&& a_job);
+            void GetCompleted(std::vector<std::unique_ptr<asyncJob_t>>& a_out);
 
-            std::vector<Triangle*> m_triangles;
-            std::uint32_t m_index;
-            bool m_hasVertex;
-            MeshPoint m_vertex;
-            float m_weight;
+            // stops and joins the threads, queued jobs are dropped
+            void Shutdown();
+
+        private:
+            void Run();
+
+            std::vector<std::thread> m_threads;
+            std::queue<std::unique_ptr<asyncJob_t>> m_queue;
+            std::vector<std::unique_ptr<asyncJob_t>> m_completed;
+
+            std::mutex m_mutex;
+            std::condition_variable m_cond;
+            bool m_stop{ false };
         };
 
     public:
 
+        enum class PrefetchPriority : std::uint32_t
+        {
+            kLow,
+            kNormal,
+            kHigh
+        };
+
         [[nodiscard]] static bool Get(
             Game::VMHandle a_handle,
             const stl::fixed_string& a_nodeName,
@@ -257,6 +381,34 @@ namespace CBP
             const configNode_t& a_nodeConfig,
             BoneResult& a_out);
 
+        // returns cached data if it's up to date, otherwise queues a background update
+        [[nodiscard]] static bool GetAsync(
+            Game::VMHandle a_handle,
+            const stl::fixed_string& a_nodeName,
+            const configNode_t& a_nodeConfig,
+            BoneResult& a_out,
+            bool& a_pending);
+
+        // moves finished background updates into the cache and queues config updates for their actors
+        static void ProcessCompleted();
+
+        [[nodiscard]] static bool IsAsync();
+
+        // thread safe, queues an actor whose BoneCast data should be read ahead of use
+        static void QueuePrefetch(
+            Game::VMHandle a_handle,
+            PrefetchPriority a_priority);
+
+        // starts background reads for queued actors, at most BoneCastPrefetchBudget per call
+        static void ProcessPrefetch();
+
+        [[nodiscard]] SKMP_FORCEINLINE static bool IsPending(
+            Game::VMHandle a_handle,
+            const stl::fixed_string& a_nodeName)
+        {
+            return m_Instance.m_pending.contains(std::make_pair(a_handle, a_nodeName));
+        }
+
         [[nodiscard]] static bool Update(
             Game::VMHandle a_handle,
             const stl::fixed_string& a_nodeName,
@@ -272,15 +424,23 @@ namespace CBP
             return m_Instance.m_cache.GetSize();
         }
 
+        [[nodiscard]] SKMP_FORCEINLINE static const auto& GetCacheInfo() {
+            return m_Instance.m_cache;
+        }
+
         [[nodiscard]] static bool ExtractGeometry(
             Actor* a_actor,
             const BSFixedString& a_nodeName,
             NiAVObject* a_armorNode,
             ColliderDataStorage& a_out);
 
-        SKMP_FORCEINLINE static void Release() {
-            m_Instance.m_cache.Release();
-        }
+        static void Release();
+
+        // opens the geometry store on the calling (main) thread
+        static void Initialize();
+
+        // must run before unload, threads can't be joined from static destructors
+        static void Shutdown();
 
     private:
 
@@ -302,31 +462,12 @@ namespace CBP
             const stl::fixed_string& a_shape,
             ColliderDataStorage& a_result);
 
-        static void RemoveDuplicateVertices(
-            const MeshPoint* a_vertices,
-            Eigen::Index a_numVertices,
-            const unsigned int* a_indices,
-            Eigen::Index a_numFaces,
-            Eigen::MatrixXf& a_verticesOut,
-            Eigen::MatrixXi& a_indicesOut);
-
-        static void RemoveUnreferencedVertices(
-            const MeshPoint* a_vertices,
-            unsigned int a_numVertices,
-            const unsigned int* a_indices,
-            std::size_t a_numIndices,
-            std::shared_ptr<MeshPoint[]>& a_verticesOut,
-            unsigned int* a_indicesOut,
-            unsigned int& a_newVertexCount
-        );
-
         [[nodiscard]] static bool CreateColliderData(
             const ColliderDataStorage& a_cds,
             const unsigned int* a_indices,
             std::size_t a_numIndices,
             ColliderData* a_out,
-            bool& a_verticesShared,
-            bool a_removeVertices);
+            bool& a_verticesShared);
 
         [[nodiscard]] static const auto& FilterIndicesByWeight(
             ColliderDataStoragePair& a_in,
@@ -339,9 +480,54 @@ namespace CBP
             float a_simplifyTarget,
             float a_simplifyTargetError);
 
+        static void ProcessAsyncJob(asyncJob_t& a_job);
+
+        static void PushAsyncJob(
+            bonecast_cache_key_t&& a_key,
+            const configNode_t& a_nodeConfig,
+            const ColliderDataStoragePair* a_source);
+
+        [[nodiscard]] bool PopPrefetch(prefetchRequest_t& a_out);
+        void RequeuePrefetch(const prefetchRequest_t& a_request);
+        void ClearPrefetch();
+
+        [[nodiscard]] static bool MakeSharedKey(
+            const ColliderDataStoragePair& a_in,
+            float a_weightThreshold,
+            float a_simplifyTarget,
+            float a_simplifyTargetError,
+            std::string& a_out);
+
+        [[nodiscard]] static bool GetShared(
+            ColliderDataStoragePair& a_in,
+            float a_weightThreshold,
+            float a_simplifyTarget,
+            float a_simplifyTargetError);
+
+        static void AddShared(
+            const ColliderDataStoragePair& a_in,
+            float a_weightThreshold,
+            float a_simplifyTarget,
+            float a_simplifyTargetError);
+
         BoneCastCache m_cache;
         IBoneCastIO m_iio;
 
+        extractScratch_t m_extractScratch;
+
+        // processed geometry by content key and parameters, shared across actors
+        std::unordered_map<std::string, std::weak_ptr<const ColliderData>> m_shared;
+
+        std::unordered_set<bonecast_cache_key_t> m_pending;
+        AsyncWorker m_worker;
+        // bumped on release, completed jobs from older generations are dropped
+        std::uint32_t m_generation{ 0 };
+
+        std::priority_queue<prefetchRequest_t> m_prefetchQueue;
+        std::unordered_map<Game::VMHandle, std::uint32_t> m_prefetchQueued;
+        std::uint64_t m_prefetchSeq{ 0 };
+        std::mutex m_prefetchLock;
+
         static IBoneCast m_Instance;
     };
 
@@ -0,0 +1,709 @@
+#include "pch.h"
+
+#include "BoneCastStore.h"
+
+#include "Common/Serialization.h"
+
+#include "BoneCast.h"
+
+#include "Drivers/cbp.h"
+
+namespace CBP
+{
+    BoneCastStore BoneCastStore::m_Instance;
+
+    BoneCastStore::mappedFile_t::mappedFile_t(const fs::path& a_path) :
+        m_file(INVALID_HANDLE_VALUE),
+        m_mapping(nullptr),
+        m_view(nullptr),
+        m_size(0)
+    {
+        m_file = ::CreateFileW(
+            a_path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+            nullptr);
+
+        if (m_file == INVALID_HANDLE_VALUE)
+            throw std::system_error(::GetLastError(), std::system_category(), a_path.string());
+
+        try
+        {
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(m_file, &size))
+                throw std::system_error(::GetLastError(), std::system_category(), a_path.string());
+
+            m_size = static_cast<std::uint64_t>(size.QuadPart);
+
+            m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping)
+                throw std::system_error(::GetLastError(), std::system_category(), a_path.string());
+
+            m_view = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!m_view)
+                throw std::system_error(::GetLastError(), std::system_category(), a_path.string());
+        }
+        catch (const std::exception&)
+        {
+            if (m_mapping)
+                ::CloseHandle(m_mapping);
+
+            ::CloseHandle(m_file);
+
+            throw;
+        }
+    }
+
+    BoneCastStore::mappedFile_t::~mappedFile_t() noexcept
+    {
+        ::UnmapViewOfFile(m_view);
+        ::CloseHandle(m_mapping);
+        ::CloseHandle(m_file);
+    }
+
+    void BoneCastStore::OpenStream(std::fstream& a_stream) const
+    {
+        a_stream.open(
+            m_path,
+            std::fstream::in |
+            std::fstream::out |
+            std::fstream::binary,
+            _SH_DENYNO);
+
+        if (!a_stream.is_open())
+            throw std::system_error(errno, std::system_category(), m_path.string());
+
+        a_stream.exceptions(std::fstream::failbit | std::fstream::badbit);
+    }
+
+    auto BoneCastStore::Find(const std::string& a_key) -> std::vector<indexEntry_t>::iterator
+    {
+        if (a_key.size() != KEY_LENGTH)
+            return m_index.end();
+
+        auto it = std::lower_bound(m_index.begin(), m_index.end(), a_key,
+            [](const indexEntry_t& a_lhs, const std::string& a_rhs) {
+                return std::memcmp(a_lhs.key, a_rhs.data(), KEY_LENGTH) < 0; });
+
+        if (it == m_index.end() || std::memcmp(it->key, a_key.data(), KEY_LENGTH) != 0)
+            return m_index.end();
+
+        return it;
+    }
+
+    auto BoneCastStore::Emplace(const std::string& a_key) -> std::vector<indexEntry_t>::iterator
+    {
+        if (a_key.size() != KEY_LENGTH)
+            throw std::exception("Bad key");
+
+        auto it = std::lower_bound(m_index.begin(), m_index.end(), a_key,
+            [](const indexEntry_t& a_lhs, const std::string& a_rhs) {
+                return std::memcmp(a_lhs.key, a_rhs.data(), KEY_LENGTH) < 0; });
+
+        if (it != m_index.end() && std::memcmp(it->key, a_key.data(), KEY_LENGTH) == 0)
+            return it;
+
+        indexEntry_t entry{};
+        std::memcpy(entry.key, a_key.data(), KEY_LENGTH);
+
+        return m_index.insert(it, entry);
+    }
+
+    // content records without an alias pointing at them are garbage
+    void BoneCastStore::UpdateLiveBytes()
+    {
+        std::unordered_set<std::uint64_t> referenced;
+
+        for (auto& e : m_index)
+        {
+            if (!(e.flags & IndexFlags::kContent))
+                referenced.emplace(e.offset);
+        }
+
+        m_liveBytes = 0;
+
+        for (auto& e : m_index)
+        {
+            if ((e.flags & IndexFlags::kContent) && referenced.contains(e.offset))
+                m_liveBytes += AlignPage(e.size);
+        }
+    }
+
+    void BoneCastStore::EnsureOpen()
+    {
+        if (m_open)
+            return;
+
+        const auto& driverConf = DCBP::GetDriverConfig();
+
+        m_path = driverConf.paths.boneCastData / "BoneCast.pack";
+        m_compress = driverConf.boneCastStoreCompression;
+
+        Serialization::CreateRootPath(m_path);
+
+        if (fs::exists(m_path))
+        {
+            try
+            {
+                Load();
+            }
+            catch (const std::exception& e)
+            {
+                Error("%s: [%s] %s, recreating store", __FUNCTION__, m_path.string().c_str(), e.what());
+                Create();
+            }
+        }
+        else
+        {
+            Create();
+        }
+
+        m_open = true;
+
+        MigrateLegacy();
+
+        // nothing is mapped yet, the file can be replaced safely
+        if (GetGarbage() > COMPACT_MIN_GARBAGE &&
+            GetGarbage() > m_liveBytes)
+        {
+            Compact();
+        }
+    }
+
+    void BoneCastStore::Open()
+    {
+        IScopedLock _(m_lock);
+
+        try
+        {
+            EnsureOpen();
+        }
+        catch (const std::exception& e)
+        {
+            Error("%s: %s", __FUNCTION__, e.what());
+        }
+    }
+
+    void BoneCastStore::Create()
+    {
+        std::ofstream ofs;
+        ofs.open(m_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc, _SH_DENYWR);
+
+        if (!ofs.is_open())
+            throw std::system_error(errno, std::system_category(), m_path.string());
+
+        ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+
+        auto page = std::make_unique<char[]>(PAGE_SIZE);
+        std::memset(page.get(), 0, PAGE_SIZE);
+
+        header_t header{};
+        header.magic = STORE_MAGIC;
+        header.version = STORE_VERSION;
+
+        std::memcpy(page.get(), &header, sizeof(header));
+
+        ofs.write(page.get(), PAGE_SIZE);
+
+        m_index.clear();
+        m_fileSize = PAGE_SIZE;
+        m_liveBytes = 0;
+    }
+
+    void BoneCastStore::Load()
+    {
+        std::ifstream ifs;
+        ifs.open(m_path, std::ifstream::in | std::ifstream::binary, _SH_DENYNO);
+
+        if (!ifs.is_open())
+            throw std::system_error(errno, std::system_category(), m_path.string());
+
+        ifs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+        header_t header;
+        ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (header.magic != STORE_MAGIC)
+            throw std::exception("Bad magic");
+
+        if (header.version != STORE_VERSION)
+            throw std::exception("Unsupported version");
+
+        ifs.seekg(0, std::ifstream::end);
+        auto fileSize = static_cast<std::uint64_t>(ifs.tellg());
+
+        if (header.indexOffset + std::uint64_t(header.indexCount) * sizeof(indexEntry_t) > fileSize)
+            throw std::exception("Index out of bounds");
+
+        m_index.resize(header.indexCount);
+
+        if (header.indexCount)
+        {
+            ifs.seekg(header.indexOffset);
+            ifs.read(reinterpret_cast<char*>(m_index.data()), m_index.size() * sizeof(indexEntry_t));
+        }
+
+        for (auto& e : m_index)
+        {
+            if (e.offset % PAGE_SIZE != 0 || e.offset + e.size > fileSize)
+                throw std::exception("Record out of bounds");
+        }
+
+        m_fileSize = AlignPage(fileSize);
+
+        UpdateLiveBytes();
+    }
+
+    void BoneCastStore::AppendRecord(
+        std::fstream& a_stream,
+        const std::string& a_contentKey,
+        const ColliderDataStorage& a_in)
+    {
+        if (a_contentKey.size() != KEY_LENGTH)
+            throw std::exception("Bad key");
+
+        recordHeader_t rh{};
+        rh.numVertices = a_in.m_numVertices;
+        rh.numWeights = static_cast<std::uint32_t>(a_in.m_weights.size());
+        rh.numIndices = static_cast<std::uint32_t>(a_in.m_indices.size());
+        rh.numTriangles = a_in.m_numTriangles;
+
+        std::memcpy(rh.contentKey, a_contentKey.data(), KEY_LENGTH);
+
+        std::string payload;
+        payload.reserve(
+            sizeof(MeshPoint) * rh.numVertices +
+            sizeof(float) * rh.numWeights +
+            sizeof(unsigned int) * rh.numIndices);
+
+        payload.append(reinterpret_cast<const char*>(a_in.m_vertices.get()), sizeof(MeshPoint) * rh.numVertices);
+        payload.append(reinterpret_cast<const char*>(a_in.m_weights.data()), sizeof(float) * rh.numWeights);
+        payload.append(reinterpret_cast<const char*>(a_in.m_indices.data()), sizeof(unsigned int) * rh.numIndices);
+
+        if (m_compress)
+        {
+            using namespace boost::iostreams;
+
+            std::string compressed;
+
+            {
+                filtering_ostream out;
+                out.push(gzip_compressor(gzip_params(zlib::best_speed)));
+                out.push(back_inserter(compressed));
+                out.write(payload.data(), payload.size());
+            }
+
+            payload.swap(compressed);
+
+            rh.flags |= RecordFlags::kCompressed;
+        }
+
+        rh.payloadSize = static_cast<std::uint32_t>(payload.size());
+
+        auto size = static_cast<std::uint32_t>(sizeof(rh) + payload.size());
+        auto offset = m_fileSize;
+
+        a_stream.seekp(offset);
+        a_stream.write(reinterpret_cast<const char*>(&rh), sizeof(rh));
+        a_stream.write(payload.data(), payload.size());
+
+        auto end = AlignPage(offset + size);
+        if (auto pad = end - (offset + size); pad > 0)
+        {
+            char zero[PAGE_SIZE]{ 0 };
+            a_stream.write(zero, pad);
+        }
+
+        m_fileSize = end;
+
+        auto it = Emplace(a_contentKey);
+
+        it->offset = offset;
+        it->size = size;
+        it->flags = IndexFlags::kContent;
+    }
+
+    bool BoneCastStore::Link(
+        const std::string& a_key,
+        const std::string& a_contentKey)
+    {
+        auto itc = Find(a_contentKey);
+        if (itc == m_index.end())
+            throw std::exception("Content record not found");
+
+        auto offset = itc->offset;
+        auto size = itc->size;
+
+        auto it = Emplace(a_key);
+
+        if (it->offset == offset && it->size == size)
+            return false;
+
+        it->offset = offset;
+        it->size = size;
+        it->flags = IndexFlags::kAlias;
+
+        return true;
+    }
+
+    void BoneCastStore::CommitIndex(std::fstream& a_stream)
+    {
+        auto offset = m_fileSize;
+        auto size = m_index.size() * sizeof(indexEntry_t);
+
+        a_stream.seekp(offset);
+
+        if (size) {
+            a_stream.write(reinterpret_cast<const char*>(m_index.data()), size);
+        }
+
+        a_stream.flush();
+
+        UpdateLiveBytes();
+
+        // header goes last so an interrupted write leaves the previous index in place
+        header_t header{};
+        header.magic = STORE_MAGIC;
+        header.version = STORE_VERSION;
+        header.indexOffset = offset;
+        header.indexCount = static_cast<std::uint32_t>(m_index.size());
+        header.liveBytes = m_liveBytes;
+
+        a_stream.seekp(0);
+        a_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        a_stream.flush();
+
+        m_fileSize = AlignPage(offset + size);
+    }
+
+    void BoneCastStore::Compact()
+    {
+        auto tmpPath(m_path);
+        tmpPath += ".tmp";
+
+        auto fileSize = m_fileSize;
+        std::uint64_t liveBytes = 0;
+
+        try
+        {
+            std::unordered_map<std::uint64_t, std::uint64_t> offsets;
+
+            for (auto& e : m_index)
+            {
+                if (!(e.flags & IndexFlags::kContent))
+                    offsets.emplace(e.offset, 0);
+            }
+
+            std::vector<indexEntry_t> index;
+            index.reserve(m_index.size());
+
+            for (auto& e : m_index)
+            {
+                if (!(e.flags & IndexFlags::kContent) || offsets.contains(e.offset))
+                    index.emplace_back(e);
+            }
+
+            {
+                std::ifstream ifs;
+                ifs.open(m_path, std::ifstream::in | std::ifstream::binary, _SH_DENYNO);
+
+                if (!ifs.is_open())
+                    throw std::system_error(errno, std::system_category(), m_path.string());
+
+                ifs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                std::ofstream ofs;
+                ofs.open(tmpPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc, _SH_DENYWR);
+
+                if (!ofs.is_open())
+                    throw std::system_error(errno, std::system_category(), tmpPath.string());
+
+                ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+
+                std::vector<char> buffer(PAGE_SIZE);
+
+                std::uint64_t offset = PAGE_SIZE;
+
+                ofs.seekp(offset);
+
+                for (auto& e : index)
+                {
+                    if (!(e.flags & IndexFlags::kContent))
+                        continue;
+
+                    auto size = AlignPage(e.size);
+
+                    if (buffer.size() < size)
+                        buffer.resize(size);
+
+                    std::memset(buffer.data() + e.size, 0, size - e.size);
+
+                    ifs.seekg(e.offset);
+                    ifs.read(buffer.data(), e.size);
+
+                    ofs.write(buffer.data(), size);
+
+                    offsets[e.offset] = offset;
+                    e.offset = offset;
+
+                    offset += size;
+                    liveBytes += size;
+                }
+
+                for (auto& e : index)
+                {
+                    if (!(e.flags & IndexFlags::kContent))
+                        e.offset = offsets[e.offset];
+                }
+
+                if (!index.empty())
+                    ofs.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(indexEntry_t));
+
+                header_t header{};
+                header.magic = STORE_MAGIC;
+                header.version = STORE_VERSION;
+                header.indexOffset = offset;
+                header.indexCount = static_cast<std::uint32_t>(index.size());
+                header.liveBytes = liveBytes;
+
+                std::memset(buffer.data(), 0, PAGE_SIZE);
+                std::memcpy(buffer.data(), &header, sizeof(header));
+
+                ofs.seekp(0);
+                ofs.write(buffer.data(), PAGE_SIZE);
+
+                fileSize = AlignPage(offset + index.size() * sizeof(indexEntry_t));
+            }
+
+            fs::rename(tmpPath, m_path);
+
+            m_index.swap(index);
+            m_fileSize = fileSize;
+            m_liveBytes = liveBytes;
+
+            Debug("%s: compacted store, %zu records (%llu kb)",
+                __FUNCTION__, m_index.size(), m_fileSize / 1024);
+        }
+        catch (const std::exception& e)
+        {
+            Serialization::SafeCleanup(tmpPath);
+            Error("%s: %s", __FUNCTION__, e.what());
+        }
+    }
+
+    // imports the per-file cache used by previous versions
+    void BoneCastStore::MigrateLegacy()
+    {
+        auto dir = m_path.parent_path();
+
+        std::vector<fs::path> migrated;
+
+        try
+        {
+            std::fstream stream;
+
+            for (const auto& entry : fs::directory_iterator(dir))
+            {
+                if (!entry.is_regular_file())
+                    continue;
+
+                auto& path = entry.path();
+                auto key = path.filename().string();
+
+                if (key.size() != KEY_LENGTH || !std::all_of(key.begin(), key.end(), ::isxdigit))
+                    continue;
+
+                try
+                {
+                    ColliderDataStoragePair data;
+
+                    {
+                        std::ifstream ifs;
+                        ifs.open(path, std::ifstream::in | std::ifstream::binary);
+
+                        if (!ifs.is_open())
+                            throw std::system_error(errno, std::system_category(), path.string());
+
+                        using namespace boost::iostreams;
+                        using namespace boost::archive;
+
+                        filtering_streambuf<input> in;
+                        in.push(gzip_decompressor(zlib::default_window_bits, 1024 * 256));
+                        in.push(ifs);
+
+                        binary_iarchive ia(in);
+
+                        ia >> data;
+                    }
+
+                    std::string contentKey;
+                    IBoneCastIO::MakeContentKey(data.first, contentKey);
+
+                    if (Find(contentKey) == m_index.end())
+                    {
+                        if (!stream.is_open())
+                            OpenStream(stream);
+
+                        AppendRecord(stream, contentKey, data.first);
+                    }
+
+                    Link(key, contentKey);
+
+                    migrated.emplace_back(path);
+                }
+                catch (const std::exception& e)
+                {
+                    Warning("%s: [%s] %s", __FUNCTION__, path.string().c_str(), e.what());
+                }
+            }
+
+            if (migrated.empty())
+                return;
+
+            if (!stream.is_open())
+                OpenStream(stream);
+
+            CommitIndex(stream);
+        }
+        catch (const std::exception& e)
+        {
+            Error("%s: %s", __FUNCTION__, e.what());
+            return;
+        }
+
+        for (auto& e : migrated)
+            Serialization::SafeCleanup(e);
+
+        Message("Migrated %zu BoneCast cache files", migrated.size());
+    }
+
+    bool BoneCastStore::Read(
+        const std::string& a_key,
+        ColliderDataStorage& a_out,
+        std::string& a_contentKey)
+    {
+        std::shared_ptr<mappedFile_t> mapping;
+        indexEntry_t entry;
+
+        {
+            IScopedLock _(m_lock);
+
+            // runs on workers, opening (migration, compaction) is left to Open
+            if (!m_open)
+                throw std::exception("Store not open");
+
+            auto it = Find(a_key);
+            if (it == m_index.end())
+                return false;
+
+            entry = *it;
+
+            if (!m_mapping || entry.offset + entry.size > m_mapping->size())
+                m_mapping = std::make_shared<mappedFile_t>(m_path);
+
+            mapping = m_mapping;
+        }
+
+        auto base = mapping->data() + entry.offset;
+        auto& rh = *reinterpret_cast<const recordHeader_t*>(base);
+
+        if (sizeof(rh) + rh.payloadSize != entry.size)
+            throw std::exception("Bad record size");
+
+        auto vertexSize = sizeof(MeshPoint) * rh.numVertices;
+        auto weightSize = sizeof(float) * rh.numWeights;
+        auto indexSize = sizeof(unsigned int) * rh.numIndices;
+
+        const std::uint8_t* payload = base + sizeof(rh);
+
+        std::string decompressed;
+
+        if (rh.flags & RecordFlags::kCompressed)
+        {
+            using namespace boost::iostreams;
+
+            filtering_istream in;
+            in.push(gzip_decompressor());
+            in.push(array_source(reinterpret_cast<const char*>(payload), rh.payloadSize));
+
+            decompressed.resize(vertexSize + weightSize + indexSize);
+
+            in.read(decompressed.data(), decompressed.size());
+
+            if (static_cast<std::size_t>(in.gcount()) != decompressed.size())
+                throw std::exception("Bad compressed record");
+
+            payload = reinterpret_cast<const std::uint8_t*>(decompressed.data());
+        }
+        else if (vertexSize + weightSize + indexSize != rh.payloadSize)
+        {
+            throw std::exception("Bad record payload");
+        }
+
+        auto vertices = reinterpret_cast<const MeshPoint*>(payload);
+        auto weights = reinterpret_cast<const float*>(payload + vertexSize);
+        auto indices = reinterpret_cast<const unsigned int*>(payload + vertexSize + weightSize);
+
+        if (rh.flags & RecordFlags::kCompressed)
+        {
+            auto tmp = std::make_unique_for_overwrite<MeshPoint[]>(rh.numVertices);
+            std::memcpy(tmp.get(), vertices, vertexSize);
+            a_out.m_vertices = std::move(tmp);
+        }
+        else
+        {
+            // shares ownership of the view, the vertex data is read-only
+            a_out.m_vertices = std::shared_ptr<MeshPoint[]>(
+                mapping, const_cast<MeshPoint*>(vertices));
+        }
+
+        a_out.m_weights.assign(weights, weights + rh.numWeights);
+        a_out.m_indices.assign(indices, indices + rh.numIndices);
+        a_out.m_numVertices = rh.numVertices;
+        a_out.m_numTriangles = rh.numTriangles;
+
+        a_contentKey.assign(rh.contentKey, KEY_LENGTH);
+
+        return true;
+    }
+
+    bool BoneCastStore::Contains(const std::string& a_key)
+    {
+        IScopedLock _(m_lock);
+
+        EnsureOpen();
+
+        return Find(a_key) != m_index.end();
+    }
+
+    void BoneCastStore::Write(
+        const std::string& a_key,
+        const std::string& a_contentKey,
+        const ColliderDataStorage& a_in)
+    {
+        IScopedLock _(m_lock);
+
+        EnsureOpen();
+
+        std::fstream stream;
+
+        if (Find(a_contentKey) == m_index.end())
+        {
+            OpenStream(stream);
+            AppendRecord(stream, a_contentKey, a_in);
+        }
+
+        if (Link(a_key, a_contentKey))
+        {
+            if (!stream.is_open())
+                OpenStream(stream);
+
+            CommitIndex(stream);
+        }
+
+        stream.close();
+    }
+}
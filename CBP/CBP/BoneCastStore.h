@@ -0,0 +1,175 @@
+#pragma once
+
+#include "ColliderData.h"
+
+namespace CBP
+{
+    // single file BoneCast geometry store
+    //
+    //  [header page][record][record]..[index][record]..[index]
+    //
+    // records are page aligned and append-only, the header points to the latest
+    // (sorted) index. uncompressed vertex blobs are mapped and used without copying.
+    //
+    // records are stored once per content key, per actor keys are index entries
+    // that point at the content record.
+    //
+    // garbage is only compacted when the store is opened, mapped records may be
+    // referenced by cached geometry at any later point.
+    class BoneCastStore :
+        ILog
+    {
+        static constexpr std::uint32_t STORE_MAGIC = 'KPCB';
+        static constexpr std::uint32_t STORE_VERSION = 1;
+        static constexpr std::uint64_t PAGE_SIZE = 4096;
+        static constexpr std::size_t KEY_LENGTH = 40;
+
+        static constexpr std::uint64_t COMPACT_MIN_GARBAGE = 1024 * 1024 * 4;
+
+        enum RecordFlags : std::uint32_t
+        {
+            kNone = 0,
+            kCompressed = 1U << 0
+        };
+
+        enum IndexFlags : std::uint32_t
+        {
+            kAlias = 0,
+            kContent = 1U << 0
+        };
+
+#pragma pack(push, 1)
+
+        struct header_t
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t indexOffset;
+            std::uint32_t indexCount;
+            std::uint32_t pad;
+            std::uint64_t liveBytes;
+        };
+
+        struct indexEntry_t
+        {
+            char key[KEY_LENGTH];
+            std::uint64_t offset;
+            std::uint32_t size;
+            std::uint32_t flags;
+        };
+
+        struct recordHeader_t
+        {
+            std::uint32_t numVertices;
+            std::uint32_t numWeights;
+            std::uint32_t numIndices;
+            std::int32_t numTriangles;
+            std::uint32_t flags;
+            std::uint32_t payloadSize;
+            char contentKey[KEY_LENGTH];
+        };
+
+#pragma pack(pop)
+
+        static_assert(sizeof(recordHeader_t) % alignof(MeshPoint) == 0);
+
+        class mappedFile_t
+        {
+        public:
+            mappedFile_t(const fs::path& a_path);
+            ~mappedFile_t() noexcept;
+
+            mappedFile_t(const mappedFile_t&) = delete;
+            mappedFile_t& operator=(const mappedFile_t&) = delete;
+
+            [[nodiscard]] SKMP_FORCEINLINE auto data() const noexcept {
+                return static_cast<const std::uint8_t*>(m_view);
+            }
+
+            [[nodiscard]] SKMP_FORCEINLINE auto size() const noexcept {
+                return m_size;
+            }
+
+        private:
+            HANDLE m_file;
+            HANDLE m_mapping;
+            void* m_view;
+            std::uint64_t m_size;
+        };
+
+    public:
+
+        [[nodiscard]] SKMP_FORCEINLINE static auto& GetSingleton() {
+            return m_Instance;
+        }
+
+        // loads, migrates and compacts the store, main thread only and before
+        // any background read is queued
+        void Open();
+
+        // the functions below throw on I/O errors, Read doesn't open the store
+        [[nodiscard]] bool Read(
+            const std::string& a_key,
+            ColliderDataStorage& a_out,
+            std::string& a_contentKey);
+
+        void Write(
+            const std::string& a_key,
+            const std::string& a_contentKey,
+            const ColliderDataStorage& a_in);
+
+        [[nodiscard]] bool Contains(const std::string& a_key);
+
+        FN_NAMEPROC("BoneCastStore");
+
+    private:
+
+        BoneCastStore() = default;
+
+        void EnsureOpen();
+        void Create();
+        void Load();
+        void MigrateLegacy();
+        void Compact();
+
+        void AppendRecord(
+            std::fstream& a_stream,
+            const std::string& a_contentKey,
+            const ColliderDataStorage& a_in);
+
+        [[nodiscard]] bool Link(
+            const std::string& a_key,
+            const std::string& a_contentKey);
+
+        void UpdateLiveBytes();
+
+        void CommitIndex(std::fstream& a_stream);
+
+        void OpenStream(std::fstream& a_stream) const;
+
+        [[nodiscard]] std::vector<indexEntry_t>::iterator Find(const std::string& a_key);
+        [[nodiscard]] std::vector<indexEntry_t>::iterator Emplace(const std::string& a_key);
+
+        [[nodiscard]] SKMP_FORCEINLINE static std::uint64_t AlignPage(std::uint64_t a_value) {
+            return (a_value + (PAGE_SIZE - 1)) & ~(PAGE_SIZE - 1);
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE std::uint64_t GetGarbage() const {
+            return m_fileSize - PAGE_SIZE - m_liveBytes;
+        }
+
+        fs::path m_path;
+        bool m_open{ false };
+        bool m_compress{ false };
+
+        std::vector<indexEntry_t> m_index;
+        std::uint64_t m_fileSize{ 0 };
+        std::uint64_t m_liveBytes{ 0 };
+
+        std::shared_ptr<mappedFile_t> m_mapping;
+
+        ICriticalSection m_lock;
+
+        static BoneCastStore m_Instance;
+    };
+}
@@ -25,4 +25,352 @@ namespace CBP
 
         return m_meta;
     }
-}
\ No newline at end of file
+
+    static bool ReduceHull(
+        const btConvexHullComputer& a_hc,
+        int a_maxVertices,
+        std::unique_ptr<MeshPoint[]>& a_out,
+        int& a_numOut)
+    {
+        int numHullVertices = a_hc.vertices.size();
+
+        if (numHullVertices < 1)
+            return false;
+
+        if (a_maxVertices < 4 || numHullVertices <= a_maxVertices)
+        {
+            a_out = std::make_unique_for_overwrite<MeshPoint[]>(numHullVertices);
+
+            for (int i = 0; i < numHullVertices; i++) {
+                a_out[i].v = a_hc.vertices[i];
+            }
+
+            a_numOut = numHullVertices;
+
+            return true;
+        }
+
+        // keep the support vertices along evenly distributed directions
+
+        auto picked = std::make_unique<bool[]>(numHullVertices);
+
+        constexpr btScalar goldenAngle = std::numbers::pi_v<btScalar> * (3.0f - std::numbers::sqrt5_v<btScalar>);
+
+        int numPicked(0);
+
+        for (int i = 0; i < a_maxVertices; i++)
+        {
+            btScalar y = 1.0f - (static_cast<btScalar>(i) + 0.5f) * 2.0f / static_cast<btScalar>(a_maxVertices);
+            btScalar r = std::sqrtf(std::max(1.0f - y * y, 0.0f));
+            btScalar phi = goldenAngle * static_cast<btScalar>(i);
+
+            btVector3 dir(std::cosf(phi) * r, y, std::sinf(phi) * r);
+
+            btScalar d;
+            int index = static_cast<int>(dir.maxDot(&a_hc.vertices[0], numHullVertices, d));
+
+            if (!picked[index])
+            {
+                picked[index] = true;
+                numPicked++;
+            }
+        }
+
+        a_out = std::make_unique_for_overwrite<MeshPoint[]>(numPicked);
+
+        for (int i = 0, j = 0; i < numHullVertices; i++)
+        {
+            if (picked[i]) {
+                a_out[j++].v = a_hc.vertices[i];
+            }
+        }
+
+        a_numOut = numPicked;
+
+        return true;
+    }
+
+    void ColliderData::GenerateHull(int a_maxVertices)
+    {
+        btConvexHullComputer hc;
+
+        hc.compute(
+            reinterpret_cast<const float*>(m_vertices.get()),
+            sizeof(decltype(m_vertices)::element_type),
+            m_numVertices,
+            0.0f,
+            0.0f);
+
+        std::unique_ptr<MeshPoint[]> hullPoints;
+
+        if (ReduceHull(hc, a_maxVertices, hullPoints, m_numHullPoints))
+        {
+            m_hullPoints = std::move(hullPoints);
+        }
+        else
+        {
+            m_hullPoints = m_vertices;
+            m_numHullPoints = m_numVertices;
+        }
+    }
+
+    struct decompositionPiece_t
+    {
+        std::vector<int> m_triangles;
+        std::unique_ptr<btConvexHullComputer> m_hull;
+        btScalar m_concavity;
+    };
+
+    // computes the hull of the triangle set and returns the depth of the deepest vertex below its surface
+    static btScalar EvaluatePiece(
+        const ColliderData& a_data,
+        decompositionPiece_t& a_piece)
+    {
+        std::vector<int> indices;
+        indices.reserve(a_piece.m_triangles.size() * 3);
+
+        for (auto e : a_piece.m_triangles)
+        {
+            for (int i = 0; i < 3; i++) {
+                indices.emplace_back(a_data.m_indices[e * 3 + i]);
+            }
+        }
+
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        btAlignedObjectArray<btVector3> points;
+        points.resize(static_cast<int>(indices.size()));
+
+        for (int i = 0; i < points.size(); i++) {
+            points[i] = a_data.m_vertices[indices[i]].v;
+        }
+
+        a_piece.m_hull = std::make_unique<btConvexHullComputer>();
+
+        auto& hc = *a_piece.m_hull;
+
+        hc.compute(
+            reinterpret_cast<const float*>(&points[0]),
+            sizeof(btVector3),
+            points.size(),
+            0.0f,
+            0.0f);
+
+        int numHullVertices = hc.vertices.size();
+        int numFaces = hc.faces.size();
+
+        if (numHullVertices < 4 || numFaces < 4)
+            return 0.0f;
+
+        btVector3 center(0.0f, 0.0f, 0.0f);
+
+        for (int i = 0; i < numHullVertices; i++) {
+            center += hc.vertices[i];
+        }
+
+        center /= static_cast<btScalar>(numHullVertices);
+
+        btAlignedObjectArray<btVector3> planes;
+        planes.reserve(numFaces);
+
+        for (int i = 0; i < numFaces; i++)
+        {
+            auto first = std::addressof(hc.edges[hc.faces[i]]);
+            auto edge = first;
+
+            btVector3 normal(0.0f, 0.0f, 0.0f);
+            btVector3 faceCenter(0.0f, 0.0f, 0.0f);
+            int n(0);
+
+            do
+            {
+                auto& a = hc.vertices[edge->getSourceVertex()];
+                auto& b = hc.vertices[edge->getTargetVertex()];
+
+                normal += a.cross(b);
+                faceCenter += a;
+                n++;
+
+                edge = edge->getNextEdgeOfFace();
+            } while (edge != first);
+
+            if (normal.length2() < SIMD_EPSILON)
+                continue;
+
+            normal.normalize();
+            faceCenter /= static_cast<btScalar>(n);
+
+            if (normal.dot(faceCenter - center) < 0.0f)
+                normal = -normal;
+
+            btVector3 plane(normal);
+            plane.setW(normal.dot(faceCenter));
+
+            planes.push_back(plane);
+        }
+
+        btScalar concavity(0.0f);
+
+        for (int i = 0; i < points.size(); i++)
+        {
+            auto& p = points[i];
+
+            btScalar depth(BT_LARGE_FLOAT);
+
+            for (int j = 0; j < planes.size(); j++)
+            {
+                auto& plane = planes[j];
+                depth = std::min(depth, plane.w() - plane.dot(p));
+            }
+
+            concavity = std::max(concavity, depth);
+        }
+
+        return concavity;
+    }
+
+    static bool SplitPiece(
+        const ColliderData& a_data,
+        const decompositionPiece_t& a_piece,
+        decompositionPiece_t& a_left,
+        decompositionPiece_t& a_right)
+    {
+        auto numTriangles = a_piece.m_triangles.size();
+
+        if (numTriangles < 2)
+            return false;
+
+        std::vector<std::pair<btScalar, int>> sorted;
+        sorted.resize(numTriangles);
+
+        btScalar best(BT_LARGE_FLOAT);
+        bool result(false);
+
+        auto half = numTriangles / 2;
+
+        // cut at the centroid median of each axis and keep the cut leaving the least concavity behind
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (std::size_t i = 0; i < numTriangles; i++)
+            {
+                auto t = a_piece.m_triangles[i];
+                auto& indices = a_data.m_indices;
+                auto base = static_cast<std::size_t>(t) * 3;
+
+                sorted[i] = std::make_pair(
+                    a_data.m_vertices[indices[base]].v[axis] +
+                    a_data.m_vertices[indices[base + 1]].v[axis] +
+                    a_data.m_vertices[indices[base + 2]].v[axis], t);
+            }
+
+            std::nth_element(sorted.begin(), sorted.begin() + half, sorted.end());
+
+            decompositionPiece_t left, right;
+
+            left.m_triangles.reserve(half);
+            right.m_triangles.reserve(numTriangles - half);
+
+            for (std::size_t i = 0; i < numTriangles; i++)
+            {
+                if (i < half)
+                    left.m_triangles.emplace_back(sorted[i].second);
+                else
+                    right.m_triangles.emplace_back(sorted[i].second);
+            }
+
+            left.m_concavity = EvaluatePiece(a_data, left);
+            right.m_concavity = EvaluatePiece(a_data, right);
+
+            auto score = std::max(left.m_concavity, right.m_concavity);
+
+            if (score < best)
+            {
+                best = score;
+
+                a_left = std::move(left);
+                a_right = std::move(right);
+
+                result = true;
+            }
+        }
+
+        return result;
+    }
+
+    const std::vector<ColliderData::hullPiece_t>& ColliderData::GetHullPieces(int a_maxPieces, int a_maxVertices) const
+    {
+        if (!m_hasHullPieces)
+        {
+            GenerateConvexDecomposition(a_maxPieces, a_maxVertices);
+            m_hasHullPieces = true;
+        }
+
+        return m_hullPieces;
+    }
+
+    void ColliderData::GenerateConvexDecomposition(int a_maxPieces, int a_maxVertices) const
+    {
+        m_hullPieces.clear();
+
+        if (a_maxPieces < 2 || m_numTriangles < 2 || m_numVertices < 1)
+            return;
+
+        btVector3 aabbMin(m_vertices[0].v);
+        btVector3 aabbMax(m_vertices[0].v);
+
+        for (int i = 1; i < m_numVertices; i++)
+        {
+            aabbMin.setMin(m_vertices[i].v);
+            aabbMax.setMax(m_vertices[i].v);
+        }
+
+        btScalar threshold = (aabbMax - aabbMin).length() * 0.005f;
+
+        std::vector<decompositionPiece_t> pieces;
+        pieces.reserve(a_maxPieces);
+
+        auto& root = pieces.emplace_back();
+
+        root.m_triangles.resize(m_numTriangles);
+        std::iota(root.m_triangles.begin(), root.m_triangles.end(), 0);
+
+        root.m_concavity = EvaluatePiece(*this, root);
+
+        while (pieces.size() < static_cast<std::size_t>(a_maxPieces))
+        {
+            auto it = std::max_element(pieces.begin(), pieces.end(),
+                [](auto& a_lhs, auto& a_rhs) {
+                    return a_lhs.m_concavity < a_rhs.m_concavity;
+                });
+
+            if (it->m_concavity <= threshold)
+                break;
+
+            decompositionPiece_t left, right;
+
+            if (!SplitPiece(*this, *it, left, right))
+            {
+                it->m_concavity = 0.0f;
+                continue;
+            }
+
+            *it = std::move(left);
+            pieces.emplace_back(std::move(right));
+        }
+
+        if (pieces.size() < 2)
+            return;
+
+        m_hullPieces.reserve(pieces.size());
+
+        for (auto& e : pieces)
+        {
+            hullPiece_t piece;
+
+            if (ReduceHull(*e.m_hull, a_maxVertices, piece.m_points, piece.m_numPoints)) {
+                m_hullPieces.emplace_back(std::move(piece));
+            }
+        }
+    }
+}
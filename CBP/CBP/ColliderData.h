@@ -61,6 +61,90 @@ namespace CBP
     struct ColliderDataStorage;
     struct ColliderDataStoragePair;
 
+    // triangle indices stored as 16 bit when every vertex is addressable with it
+    class ColliderIndexBuffer
+    {
+    public:
+
+        ColliderIndexBuffer() :
+            m_numIndices(0),
+            m_elementSize(sizeof(int))
+        {
+        }
+
+        template <class T>
+        void Assign(const T* a_indices, std::size_t a_numIndices, std::size_t a_numVertices);
+
+        SKMP_FORCEINLINE void CopyFrom(const ColliderIndexBuffer& a_rhs)
+        {
+            auto size = a_rhs.GetSize();
+
+            m_data = std::make_unique_for_overwrite<std::uint8_t[]>(size);
+            std::memcpy(m_data.get(), a_rhs.m_data.get(), size);
+
+            m_numIndices = a_rhs.m_numIndices;
+            m_elementSize = a_rhs.m_elementSize;
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE int operator[](std::size_t a_index) const
+        {
+            return IsShort() ?
+                static_cast<int>(reinterpret_cast<const std::uint16_t*>(m_data.get())[a_index]) :
+                reinterpret_cast<const int*>(m_data.get())[a_index];
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE bool IsShort() const noexcept {
+            return m_elementSize == sizeof(std::uint16_t);
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE const std::uint8_t* GetData() const noexcept {
+            return m_data.get();
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE std::size_t GetElementSize() const noexcept {
+            return m_elementSize;
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE std::size_t GetSize() const noexcept {
+            return m_numIndices * m_elementSize;
+        }
+
+    private:
+
+        std::unique_ptr<std::uint8_t[]> m_data;
+        std::size_t m_numIndices;
+        std::size_t m_elementSize;
+    };
+
+    template <class T>
+    void ColliderIndexBuffer::Assign(const T* a_indices, std::size_t a_numIndices, std::size_t a_numVertices)
+    {
+        m_numIndices = a_numIndices;
+
+        if (a_numVertices <= std::size_t(std::numeric_limits<std::uint16_t>::max()) + 1)
+        {
+            m_elementSize = sizeof(std::uint16_t);
+            m_data = std::make_unique_for_overwrite<std::uint8_t[]>(GetSize());
+
+            auto out = reinterpret_cast<std::uint16_t*>(m_data.get());
+
+            for (std::size_t i = 0; i < a_numIndices; i++) {
+                out[i] = static_cast<std::uint16_t>(a_indices[i]);
+            }
+        }
+        else
+        {
+            m_elementSize = sizeof(int);
+            m_data = std::make_unique_for_overwrite<std::uint8_t[]>(GetSize());
+
+            auto out = reinterpret_cast<int*>(m_data.get());
+
+            for (std::size_t i = 0; i < a_numIndices; i++) {
+                out[i] = static_cast<int>(a_indices[i]);
+            }
+        }
+    }
+
     struct ColliderData
     {
         friend class ColliderProfile;
@@ -69,10 +153,18 @@ namespace CBP
 
         SKMP_DECLARE_ALIGNED_ALLOCATOR_AUTO();
 
+        struct hullPiece_t
+        {
+            std::unique_ptr<MeshPoint[]> m_points;
+            int m_numPoints;
+        };
+
         ColliderData() :
             m_numIndices(0),
             m_numVertices(0),
             m_numTriangles(0),
+            m_numHullPoints(0),
+            m_hasHullPieces(false),
             m_size(sizeof(ColliderData))
         {
         };
@@ -100,14 +192,21 @@ namespace CBP
         };
 
         SKMP_FORCEINLINE void GenerateTriVertexArray();
+        void GenerateHull(int a_maxVertices);
 
+        // decomposed on first use and kept, main thread only
+        [[nodiscard]] const std::vector<hullPiece_t>& GetHullPieces(int a_maxPieces, int a_maxVertices) const;
+
+        // immutable once built, copies share it
         std::shared_ptr<MeshPoint[]> m_vertices;
-        std::unique_ptr<MeshPoint[]> m_hullPoints;
-        std::unique_ptr<int[]> m_indices;
+        // aliases m_vertices when the hull couldn't be reduced
+        std::shared_ptr<MeshPoint[]> m_hullPoints;
+        ColliderIndexBuffer m_indices;
 
         int m_numVertices;
         int m_numTriangles;
         int m_numIndices;
+        int m_numHullPoints;
 
         std::unique_ptr<btTriangleIndexVertexArray> m_triVertexArray;
 
@@ -122,6 +221,11 @@ namespace CBP
         SKMP_FORCEINLINE void __move(ColliderData&& a_rhs);
         SKMP_FORCEINLINE void __copy(const ColliderData& a_rhs);
 
+        void GenerateConvexDecomposition(int a_maxPieces, int a_maxVertices) const;
+
+        mutable std::vector<hullPiece_t> m_hullPieces;
+        mutable bool m_hasHullPieces;
+
         mutable std::size_t m_size;
     };
 
@@ -134,6 +238,12 @@ namespace CBP
         m_numVertices = a_rhs.m_numVertices;
         m_numTriangles = a_rhs.m_numTriangles;
         m_numIndices = a_rhs.m_numIndices;
+        m_numHullPoints = a_rhs.m_numHullPoints;
+
+        m_hullPieces = std::move(a_rhs.m_hullPieces);
+        m_hasHullPieces = a_rhs.m_hasHullPieces;
+
+        a_rhs.m_hasHullPieces = false;
 
         m_triVertexArray = std::move(a_rhs.m_triVertexArray);
 
@@ -142,19 +252,17 @@ namespace CBP
 
     void ColliderData::__copy(const ColliderData& a_rhs)
     {
-        auto tmp = std::make_unique_for_overwrite<MeshPoint[]>(a_rhs.m_numVertices);
-        m_hullPoints = std::make_unique_for_overwrite<MeshPoint[]>(a_rhs.m_numIndices);
-        m_indices = std::make_unique_for_overwrite<int[]>(a_rhs.m_numIndices);
-
-        std::memcpy(tmp.get(), a_rhs.m_vertices.get(), sizeof(decltype(m_vertices)::element_type) * a_rhs.m_numVertices);
-        std::memcpy(m_hullPoints.get(), a_rhs.m_hullPoints.get(), sizeof(decltype(m_hullPoints)::element_type) * a_rhs.m_numIndices);
-        std::memcpy(m_indices.get(), a_rhs.m_indices.get(), sizeof(decltype(m_indices)::element_type) * a_rhs.m_numIndices);
-
-        m_vertices = std::move(tmp);
+        m_vertices = a_rhs.m_vertices;
+        m_hullPoints = a_rhs.m_hullPoints;
+        m_indices.CopyFrom(a_rhs.m_indices);
 
         m_numVertices = a_rhs.m_numVertices;
         m_numTriangles = a_rhs.m_numTriangles;
         m_numIndices = a_rhs.m_numIndices;
+        m_numHullPoints = a_rhs.m_numHullPoints;
+
+        m_hullPieces.clear();
+        m_hasHullPieces = false;
 
         GenerateTriVertexArray();
         UpdateSize();
@@ -164,8 +272,11 @@ namespace CBP
     {
         m_size =
             sizeof(ColliderData) +
-            sizeof(decltype(m_hullPoints)::element_type) * m_numIndices +
-            sizeof(decltype(m_indices)::element_type) * m_numIndices;
+            m_indices.GetSize();
+
+        if (m_hullPoints != m_vertices) {
+            m_size += sizeof(decltype(m_hullPoints)::element_type) * m_numHullPoints;
+        }
 
         if (!a_ignoreVertex) {
             m_size += sizeof(decltype(m_vertices)::element_type) * m_numVertices;
@@ -178,10 +289,19 @@ namespace CBP
 
     void ColliderData::GenerateTriVertexArray()
     {
-        m_triVertexArray = std::make_unique<btTriangleIndexVertexArray>(
-            m_numTriangles, m_indices.get(), sizeof(int) * 3,
-            m_numVertices, m_vertices.get()->v,
-            sizeof(decltype(m_vertices)::element_type::v));
+        btIndexedMesh mesh;
+
+        mesh.m_numTriangles = m_numTriangles;
+        mesh.m_triangleIndexBase = m_indices.GetData();
+        mesh.m_triangleIndexStride = static_cast<int>(m_indices.GetElementSize() * 3);
+        mesh.m_numVertices = m_numVertices;
+        mesh.m_vertexBase = reinterpret_cast<const unsigned char*>(m_vertices.get());
+        mesh.m_vertexStride = sizeof(decltype(m_vertices)::element_type);
+
+        m_triVertexArray = std::make_unique<btTriangleIndexVertexArray>();
+        m_triVertexArray->addIndexedMesh(
+            mesh,
+            m_indices.IsShort() ? PHY_SHORT : PHY_INTEGER);
     }
 
 
@@ -268,6 +388,32 @@ namespace CBP
             m_indices.capacity() * sizeof(decltype(m_indices)::value_type);
     }
 
+    // intermediate BoneCast results, not serialized
+    struct BoneCastStages
+    {
+        SKMP_FORCEINLINE std::size_t GetSize() const
+        {
+            return
+                filteredIndices.capacity() * sizeof(decltype(filteredIndices)::value_type) +
+                simplifiedIndices.capacity() * sizeof(decltype(simplifiedIndices)::value_type);
+        }
+
+        // weight filter, empty when the threshold is <= 0
+        std::vector<unsigned int> filteredIndices;
+        float weightThreshold{ 0.0f };
+        bool filtered{ false };
+
+        // simplification, empty when it didn't reduce the index count
+        std::vector<unsigned int> simplifiedIndices;
+        float simplifyTarget{ 0.0f };
+        float simplifyTargetError{ 0.0f };
+        bool simplified{ false };
+        bool simplifyApplied{ false };
+
+        // second was built from the stages above
+        bool built{ false };
+    };
+
     struct ColliderDataStoragePair
     {
     private:
@@ -310,6 +456,11 @@ namespace CBP
         ColliderDataStorage first;
         std::shared_ptr<const ColliderData> second;
 
+        // source geometry hash, not serialized
+        std::string contentKey;
+
+        BoneCastStages stages;
+
         SKMP_FORCEINLINE std::size_t GetSize() const {
             return m_size;
         }
@@ -347,7 +498,8 @@ namespace CBP
         return (m_size =
             sizeof(ColliderDataStoragePair) +
             first.GetSize() +
-            second->GetSize());
+            second->GetSize() +
+            stages.GetSize());
     }
 
     void ColliderDataStoragePair::SetVerticesShared(bool a_switch)
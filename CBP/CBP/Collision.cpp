@@ -3,6 +3,9 @@
 #include "Collision.h"
 #include "ColliderData.h"
 #include "SimComponent.h"
+#include "VertexWeld.h"
+
+#include "Drivers/cbp.h"
 
 namespace CBP
 {
@@ -91,92 +94,346 @@ namespace CBP
         }
     }
 
-    bool ColliderProfile::Load()
+    fs::path ColliderProfile::GetCachePath(const fs::path& a_source)
+    {
+        auto path(a_source);
+        path += ".cache";
+        return path;
+    }
+
+    bool ColliderProfile::MakeCacheKey(cacheKey_t& a_out) const
+    {
+        std::error_code ec;
+
+        auto size = fs::file_size(m_path, ec);
+        if (ec)
+            return false;
+
+        auto time = fs::last_write_time(m_path, ec);
+        if (ec)
+            return false;
+
+        const auto& driverConf = DCBP::GetDriverConfig();
+
+        std::memset(std::addressof(a_out), 0x0, sizeof(a_out));
+
+        a_out.magic = CACHE_MAGIC;
+        a_out.version = CACHE_VERSION;
+        a_out.importFlags = static_cast<std::uint32_t>(IMPORT_FLAGS);
+        a_out.rvcFlags = static_cast<std::uint32_t>(IMPORT_RVC_FLAGS);
+        a_out.weldEpsilon = WELD_EPSILON;
+        a_out.hullMaxVertices = driverConf.convexHullMaxVertices;
+        a_out.sourceSize = static_cast<std::uint64_t>(size);
+        a_out.sourceTime = static_cast<std::int64_t>(time.time_since_epoch().count());
+
+        return true;
+    }
+
+    bool ColliderProfile::LoadCache(const cacheKey_t& a_key, prepared_t& a_out) const
     {
         try
         {
-            if (m_path.empty())
-                throw std::exception("Bad path");
+            std::ifstream ifs;
+            ifs.open(GetCachePath(m_path), std::ifstream::in | std::ifstream::binary, _SH_DENYNO);
 
-            Assimp::Importer importer;
+            if (!ifs.is_open())
+                return false;
 
-            importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, IMPORT_RVC_FLAGS);
+            ifs.seekg(0, std::ifstream::end);
+            auto size = static_cast<std::size_t>(ifs.tellg());
+            ifs.seekg(0, std::ifstream::beg);
 
-            auto scene = importer.ReadFile(m_pathStr, IMPORT_FLAGS);
+            if (size < sizeof(cacheHeader_t))
+                return false;
 
-            if (!scene || !scene->mRootNode)
-                throw std::exception("No mesh was loaded");
+            auto buffer = std::make_unique_for_overwrite<char[]>(size);
 
-            if (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
-                throw std::exception("Incomplete scene");
+            if (!ifs.read(buffer.get(), size))
+                return false;
 
-            if (!scene->mMeshes || scene->mNumMeshes < 1)
-                throw std::exception("No data");
+            auto& header = *reinterpret_cast<const cacheHeader_t*>(buffer.get());
 
-            auto mesh = scene->mMeshes[0];
+            if (!(header.key == a_key))
+                return false;
+
+            if (header.numVertices < 1 ||
+                header.numIndices < 3 ||
+                header.numIndices % 3 != 0)
+            {
+                return false;
+            }
 
-            if (!mesh->HasPositions() || !mesh->HasFaces())
-                throw std::exception("Missing data");
+            bool hullAliased = (header.flags & CacheFlags::kHullAliased) == CacheFlags::kHullAliased;
 
-            int numVertices = static_cast<int>(mesh->mNumVertices);
-            int numFaces = static_cast<int>(mesh->mNumFaces);
+            std::size_t offset = sizeof(cacheHeader_t);
 
-            if (numVertices < 1)
-                throw std::exception("No vertices");
+            auto take = [&](std::size_t a_size) -> const char*
+            {
+                if (a_size > size - offset)
+                    throw std::exception("Truncated cache");
 
-            if (numFaces < 1)
-                throw std::exception("No faces");
+                auto p = buffer.get() + offset;
+                offset += a_size;
+                return p;
+            };
 
             auto tmp = std::make_unique<ColliderData>();
 
-            tmp->m_vertices = std::make_unique_for_overwrite<MeshPoint[]>(std::size_t(numVertices));
+            auto vertices = std::make_unique_for_overwrite<MeshPoint[]>(header.numVertices);
+            std::memcpy(vertices.get(), take(sizeof(MeshPoint) * header.numVertices), sizeof(MeshPoint) * header.numVertices);
+
+            auto indices = reinterpret_cast<const std::uint32_t*>(
+                take(sizeof(std::uint32_t) * header.numIndices));
+
+            for (std::uint32_t i = 0; i < header.numIndices; i++)
+            {
+                if (indices[i] >= header.numVertices)
+                    return false;
+            }
 
-            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            tmp->m_vertices = std::move(vertices);
+            tmp->m_indices.Assign(indices, header.numIndices, header.numVertices);
+            tmp->m_numVertices = static_cast<int>(header.numVertices);
+            tmp->m_numIndices = static_cast<int>(header.numIndices);
+            tmp->m_numTriangles = static_cast<int>(header.numIndices / 3);
+
+            if (hullAliased)
+            {
+                tmp->m_hullPoints = tmp->m_vertices;
+                tmp->m_numHullPoints = tmp->m_numVertices;
+            }
+            else
             {
-                auto& e = mesh->mVertices[i];
-                tmp->m_vertices[i] = MeshPoint(e.x, e.y, e.z);
+                auto hullPoints = std::make_unique_for_overwrite<MeshPoint[]>(header.numHullPoints);
+                std::memcpy(hullPoints.get(), take(sizeof(MeshPoint) * header.numHullPoints), sizeof(MeshPoint) * header.numHullPoints);
+
+                tmp->m_hullPoints = std::move(hullPoints);
+                tmp->m_numHullPoints = static_cast<int>(header.numHullPoints);
             }
 
-            int numIndices(0);
+            std::string desc(take(header.descLength), header.descLength);
+
+            tmp->GenerateTriVertexArray();
+            tmp->UpdateSize();
+
+            a_out.data = std::move(tmp);
+            a_out.desc = std::move(desc);
+
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    void ColliderProfile::SaveCache(const cacheKey_t& a_key, const ColliderData& a_data)
+    {
+        try
+        {
+            const auto& desc = GetDescription();
+
+            cacheHeader_t header;
+            std::memset(std::addressof(header), 0x0, sizeof(header));
+
+            bool hullAliased = a_data.m_hullPoints == a_data.m_vertices;
+
+            header.key = a_key;
+            header.flags = hullAliased ? CacheFlags::kHullAliased : 0;
+            header.numVertices = static_cast<std::uint32_t>(a_data.m_numVertices);
+            header.numIndices = static_cast<std::uint32_t>(a_data.m_numIndices);
+            header.numHullPoints = hullAliased ? 0 : static_cast<std::uint32_t>(a_data.m_numHullPoints);
+            header.descLength = desc ? static_cast<std::uint32_t>(desc->size()) : 0;
+
+            std::string s;
 
-            for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+            s.append(reinterpret_cast<const char*>(std::addressof(header)), sizeof(header));
+            s.append(reinterpret_cast<const char*>(a_data.m_vertices.get()), sizeof(MeshPoint) * header.numVertices);
+
+            for (std::uint32_t i = 0; i < header.numIndices; i++)
             {
-                int n = static_cast<int>(mesh->mFaces[i].mNumIndices);
+                auto index = static_cast<std::uint32_t>(a_data.m_indices[i]);
+                s.append(reinterpret_cast<const char*>(std::addressof(index)), sizeof(index));
+            }
 
-                if (n != 3)
-                    throw std::exception("aiFace.mNumIndices != 3");
+            if (!hullAliased) {
+                s.append(reinterpret_cast<const char*>(a_data.m_hullPoints.get()), sizeof(MeshPoint) * header.numHullPoints);
+            }
 
-                numIndices += n;
+            if (desc) {
+                s.append(*desc);
             }
 
-            if (numIndices < 1)
-                throw std::exception("No indices");
+            auto path = GetCachePath(m_path);
 
-            tmp->m_indices = std::make_unique_for_overwrite<int[]>(std::size_t(numIndices));
-            tmp->m_hullPoints = std::make_unique_for_overwrite<MeshPoint[]>(std::size_t(numIndices));
+            auto tmpPath(path);
+            tmpPath += ".tmp";
 
-            for (unsigned int i = 0, n = 0; i < mesh->mNumFaces; i++)
             {
-                auto& e = mesh->mFaces[i];
+                std::ofstream ofs;
+                ofs.open(tmpPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc, _SH_DENYWR);
 
-                for (unsigned int j = 0; j < e.mNumIndices; j++, n++)
-                {
-                    int index = static_cast<int>(e.mIndices[j]);
+                if (!ofs.is_open())
+                    throw std::exception("Could not open file for writing");
 
-                    tmp->m_indices[n] = index;
-                    tmp->m_hullPoints[n] = tmp->m_vertices[index];
-                }
+                ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+                ofs.write(s.data(), s.size());
             }
 
-            tmp->m_numVertices = numVertices;
-            tmp->m_numTriangles = numFaces;
-            tmp->m_numIndices = numIndices;
+            fs::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Warning("%s: %s: %s", __FUNCTION__, m_pathStr.c_str(), e.what());
+        }
+    }
+
+    void ColliderProfile::Prepare()
+    {
+        auto prepared = std::make_shared<prepared_t>();
 
-            tmp->GenerateTriVertexArray();
+        try
+        {
+            Read(*prepared);
+        }
+        catch (const std::exception&)
+        {
+            prepared->error = std::current_exception();
+        }
+
+        m_prepared = std::move(prepared);
+    }
+
+    // no logging or shared state, runs on worker threads through Prepare
+    void ColliderProfile::Read(prepared_t& a_out) const
+    {
+        if (m_path.empty())
+            throw std::exception("Bad path");
+
+        a_out.save = false;
+
+        bool hasKey = MakeCacheKey(a_out.key);
+
+        if (hasKey && LoadCache(a_out.key, a_out))
+            return;
+
+        Assimp::Importer importer;
+
+        importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, IMPORT_RVC_FLAGS);
+
+        auto scene = importer.ReadFile(m_pathStr, IMPORT_FLAGS);
+
+        if (!scene || !scene->mRootNode)
+            throw std::exception("No mesh was loaded");
+
+        if (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+            throw std::exception("Incomplete scene");
+
+        if (!scene->mMeshes || scene->mNumMeshes < 1)
+            throw std::exception("No data");
+
+        auto mesh = scene->mMeshes[0];
+
+        if (!mesh->HasPositions() || !mesh->HasFaces())
+            throw std::exception("Missing data");
+
+        int numVertices = static_cast<int>(mesh->mNumVertices);
+        int numFaces = static_cast<int>(mesh->mNumFaces);
+
+        if (numVertices < 1)
+            throw std::exception("No vertices");
+
+        if (numFaces < 1)
+            throw std::exception("No faces");
+
+        auto vertices = std::make_unique_for_overwrite<MeshPoint[]>(std::size_t(numVertices));
+
+        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+        {
+            auto& e = mesh->mVertices[i];
+            vertices[i] = MeshPoint(e.x, e.y, e.z);
+        }
+
+        int numIndices(0);
+
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        {
+            int n = static_cast<int>(mesh->mFaces[i].mNumIndices);
+
+            if (n != 3)
+                throw std::exception("aiFace.mNumIndices != 3");
+
+            numIndices += n;
+        }
+
+        if (numIndices < 1)
+            throw std::exception("No indices");
+
+        auto tmp = std::make_unique<ColliderData>();
 
-            m_data = std::move(tmp);
+        auto indices = std::make_unique_for_overwrite<int[]>(std::size_t(numIndices));
 
-            SetDescription(mesh->mName.C_Str());
+        for (unsigned int i = 0, n = 0; i < mesh->mNumFaces; i++)
+        {
+            auto& e = mesh->mFaces[i];
+
+            for (unsigned int j = 0; j < e.mNumIndices; j++, n++)
+            {
+                indices[n] = static_cast<int>(e.mIndices[j]);
+            }
+        }
+
+        std::unique_ptr<MeshPoint[]> welded;
+
+        numVertices = static_cast<int>(WeldVertices(
+            vertices.get(),
+            static_cast<std::uint32_t>(numVertices),
+            indices.get(),
+            static_cast<std::size_t>(numIndices),
+            WELD_EPSILON,
+            welded,
+            indices.get()));
+
+        tmp->m_vertices = std::move(welded);
+        tmp->m_indices.Assign(indices.get(), std::size_t(numIndices), std::size_t(numVertices));
+        tmp->m_numVertices = numVertices;
+        tmp->m_numTriangles = numFaces;
+        tmp->m_numIndices = numIndices;
+
+        tmp->GenerateTriVertexArray();
+
+        const auto& driverConf = DCBP::GetDriverConfig();
+
+        tmp->GenerateHull(driverConf.convexHullMaxVertices);
+
+        a_out.data = std::move(tmp);
+        a_out.desc = mesh->mName.C_Str();
+        a_out.save = hasKey;
+    }
+
+    bool ColliderProfile::Load()
+    {
+        try
+        {
+            auto prepared = std::move(m_prepared);
+
+            if (!prepared)
+            {
+                prepared = std::make_shared<prepared_t>();
+                Read(*prepared);
+            }
+            else if (prepared->error)
+            {
+                std::rethrow_exception(prepared->error);
+            }
+
+            if (prepared->save) {
+                SaveCache(prepared->key, *prepared->data);
+            }
+
+            m_data = std::move(prepared->data);
+
+            SetDescription(std::move(prepared->desc));
 
             /*Debug("%s (%s): vertices: %d, indices: %d, faces: %d",
                 m_name.c_str(), m_desc->c_str(), numVertices, numIndices, numFaces);*/
@@ -198,16 +455,241 @@ namespace CBP
         btBroadphaseProxy* proxy0,
         btBroadphaseProxy* proxy1) const
     {
-        auto o1 = static_cast<const btCollisionObject*>(proxy0->m_clientObject);
-        auto o2 = static_cast<const btCollisionObject*>(proxy1->m_clientObject);
-
-        auto sc1 = static_cast<const SimComponent*>(o1->getUserPointer());
-        auto sc2 = static_cast<const SimComponent*>(o2->getUserPointer());
+        auto g0 = proxy0->m_collisionFilterGroup;
+        auto g1 = proxy1->m_collisionFilterGroup;
 
-        if (!sc1->HasMotion() && !sc2->HasMotion())
+        if (((g0 | g1) & FILTER_FLAG_MOTION) == 0)
             return false;
 
-        return !sc1->IsSameGroup(*sc2);
+        auto i0 = static_cast<std::uint32_t>(g0 & FILTER_GROUP_INDEX_MASK);
+        auto i1 = static_cast<std::uint32_t>(g1 & FILTER_GROUP_INDEX_MASK);
+
+        bool self = proxy0->m_collisionFilterMask == proxy1->m_collisionFilterMask;
+
+        if (i0 < MAX_COLLISION_LAYERS && i1 < MAX_COLLISION_LAYERS)
+        {
+            auto& layer = m_Instance.m_layers[i0];
+            return ((self ? layer.self : layer.other) & (1ULL << i1)) != 0;
+        }
+
+        return !(self && i0 != 0 && i0 == i1);
+    }
+
+    void ICollision::collisionWorld::updateAabbs()
+    {
+        BT_PROFILE("updateAabbs");
+
+        const auto& globalConfig = IConfig::GetGlobal();
+
+        m_Instance.m_swept = globalConfig.phys.sweptBroadphase;
+
+        if (m_Instance.m_swept)
+        {
+            updateAabbsSwept();
+            return;
+        }
+
+        m_Instance.m_sweptReset = true;
+
+        for (int i = 0; i < m_collisionObjects.size(); i++)
+        {
+            auto colObj = m_collisionObjects[i];
+
+            if (colObj->getUserIndex() == 0) {
+                continue;
+            }
+
+            updateSingleAabb(colObj);
+
+            colObj->setUserIndex(0);
+
+            m_Instance.m_proxiesMoved = true;
+        }
+    }
+
+    void ICollision::collisionWorld::computeOverlappingPairs()
+    {
+        if (!m_Instance.m_proxiesMoved)
+            return;
+
+        m_Instance.m_proxiesMoved = false;
+
+        btCollisionWorld::computeOverlappingPairs();
+    }
+
+    static SKMP_FORCEINLINE bool AabbContains(
+        const btVector3& a_outerMin,
+        const btVector3& a_outerMax,
+        const btVector3& a_innerMin,
+        const btVector3& a_innerMax)
+    {
+        return
+            a_innerMin.x() >= a_outerMin.x() && a_innerMax.x() <= a_outerMax.x() &&
+            a_innerMin.y() >= a_outerMin.y() && a_innerMax.y() <= a_outerMax.y() &&
+            a_innerMin.z() >= a_outerMin.z() && a_innerMax.z() <= a_outerMax.z();
+    }
+
+    // broadphase proxies get AABBs swept over the predicted frame motion once per frame,
+    // substeps only touch the broadphase for objects that leave their swept AABB.
+    // objects that didn't move and aren't dirty keep their proxy as is
+    void ICollision::collisionWorld::updateAabbsSwept()
+    {
+        auto& states = m_Instance.m_sweptStates;
+
+        bool frameStart = m_Instance.m_sweptFrameStart;
+        bool reset = m_Instance.m_sweptReset || states.size() != static_cast<std::size_t>(m_collisionObjects.size());
+
+        if (reset)
+            states.resize(m_collisionObjects.size());
+
+        btVector3 contactThreshold(
+            gContactBreakingThreshold,
+            gContactBreakingThreshold,
+            gContactBreakingThreshold);
+
+        for (int i = 0; i < m_collisionObjects.size(); i++)
+        {
+            auto colObj = m_collisionObjects[i];
+            auto& state = states[i];
+
+            auto& origin = colObj->getWorldTransform().getOrigin();
+
+            bool update = reset || colObj->getUserIndex() != 0;
+
+            if (reset)
+            {
+                state.origin = origin;
+                state.motion.setZero();
+            }
+            else if (frameStart)
+            {
+                auto motion(origin - state.origin);
+
+                // one more pass after stopping shrinks the proxy back
+                update |= !motion.isZero() || !state.motion.isZero();
+
+                state.motion = motion;
+                state.origin = origin;
+            }
+
+            if (!update)
+                continue;
+
+            colObj->setUserIndex(0);
+
+            colObj->getCollisionShape()->getAabb(
+                colObj->getWorldTransform(), state.aabbMin, state.aabbMax);
+
+            state.aabbMin -= contactThreshold;
+            state.aabbMax += contactThreshold;
+
+            auto proxy = colObj->getBroadphaseHandle();
+
+            if (!reset && !frameStart &&
+                AabbContains(proxy->m_aabbMin, proxy->m_aabbMax, state.aabbMin, state.aabbMax))
+            {
+                continue;
+            }
+
+            auto sweptMin(state.aabbMin);
+            auto sweptMax(state.aabbMax);
+
+            sweptMin.setMin(state.aabbMin + state.motion);
+            sweptMax.setMax(state.aabbMax + state.motion);
+
+            m_broadphasePairCache->setAabb(proxy, sweptMin, sweptMax, m_dispatcher1);
+
+            m_Instance.m_proxiesMoved = true;
+        }
+
+        m_Instance.m_sweptFrameStart = false;
+        m_Instance.m_sweptReset = false;
+    }
+
+    void ICollision::collisionWorld::performDiscreteCollisionDetection()
+    {
+        const auto& globalConfig = IConfig::GetGlobal();
+
+        m_Instance.m_profiling = globalConfig.profiling.enableProfiling;
+
+        if (!m_Instance.m_profiling)
+        {
+            btCollisionWorld::performDiscreteCollisionDetection();
+            return;
+        }
+
+        BT_PROFILE("performDiscreteCollisionDetection");
+
+        auto& dispatchInfo = getDispatchInfo();
+
+        auto t0 = IPerfCounter::Query();
+
+        updateAabbs();
+        computeOverlappingPairs();
+
+        auto t1 = IPerfCounter::Query();
+
+        auto pairCache = m_broadphasePairCache->getOverlappingPairCache();
+
+        if (m_dispatcher1)
+        {
+            BT_PROFILE("dispatchAllCollisionPairs");
+            m_dispatcher1->dispatchAllCollisionPairs(pairCache, dispatchInfo, m_dispatcher1);
+        }
+
+        auto t2 = IPerfCounter::Query();
+
+        auto& profiler = m_Instance.m_profiler;
+
+        profiler.AddBroadphase(t1 - t0, static_cast<std::uint32_t>(pairCache->getNumOverlappingPairs()));
+        profiler.AddNarrowphase(t2 - t1);
+    }
+
+    void ICollision::NearCallback(
+        btBroadphasePair& a_pair,
+        btCollisionDispatcher& a_dispatcher,
+        const btDispatcherInfo& a_dispatchInfo)
+    {
+        auto ob0 = static_cast<btCollisionObject*>(a_pair.m_pProxy0->m_clientObject);
+        auto ob1 = static_cast<btCollisionObject*>(a_pair.m_pProxy1->m_clientObject);
+
+        if (m_Instance.m_swept)
+        {
+            auto& s0 = m_Instance.m_sweptStates[ob0->getWorldArrayIndex()];
+            auto& s1 = m_Instance.m_sweptStates[ob1->getWorldArrayIndex()];
+
+            // swept AABBs overlap but the objects don't, drop stale contacts and skip the narrowphase
+            if (!TestAabbAgainstAabb2(s0.aabbMin, s0.aabbMax, s1.aabbMin, s1.aabbMax))
+            {
+                if (a_pair.m_algorithm)
+                {
+                    btManifoldArray manifolds;
+                    a_pair.m_algorithm->getAllContactManifolds(manifolds);
+
+                    for (int i = 0; i < manifolds.size(); i++) {
+                        manifolds[i]->clearManifold();
+                    }
+                }
+
+                return;
+            }
+        }
+
+        if (m_Instance.m_profiling)
+        {
+            auto start = IPerfCounter::Query();
+
+            btCollisionDispatcher::defaultNearCallback(a_pair, a_dispatcher, a_dispatchInfo);
+
+            m_Instance.m_profiler.AddPair(
+                static_cast<const SimComponent*>(ob0->getUserPointer()),
+                static_cast<const SimComponent*>(ob1->getUserPointer()),
+                IPerfCounter::Query() - start);
+        }
+        else
+        {
+            btCollisionDispatcher::defaultNearCallback(a_pair, a_dispatcher, a_dispatchInfo);
+        }
     }
 
     void ICollision::Initialize(
@@ -263,13 +745,57 @@ namespace CBP
             ptrs.bt_dispatcher->setDispatcherFlags(flags);
         }
 
-        auto world = new btCollisionWorld(ptrs.bt_dispatcher, ptrs.bt_broadphase, ptrs.bt_collision_configuration);
+        auto world = new collisionWorld(ptrs.bt_dispatcher, ptrs.bt_broadphase, ptrs.bt_collision_configuration);
         world->getPairCache()->setOverlapFilterCallback(&m_Instance.m_overlapFilter);
 
         ptrs.bt_collision_world = world;
 
         btGImpactCollisionAlgorithm::registerAlgorithm(ptrs.bt_dispatcher);
 
+        ptrs.bt_dispatcher->setNearCallback(NearCallback);
+
+        UpdateCollisionLayers();
+    }
+
+    void ICollision::UpdateCollisionLayers()
+    {
+        auto& colGroups = IConfig::GetCollisionGroups();
+
+        // layer indices match SimComponent::m_groupIndex, 0 is ungrouped
+        std::uint64_t groups[MAX_COLLISION_LAYERS];
+        std::uint32_t numGroups(0);
+
+        groups[numGroups++] = 0;
+
+        for (auto& e : colGroups)
+        {
+            if (numGroups == MAX_COLLISION_LAYERS)
+                break;
+
+            groups[numGroups++] = e;
+        }
+
+        for (std::uint32_t i = 0; i < MAX_COLLISION_LAYERS; i++)
+        {
+            auto& layer = m_Instance.m_layers[i];
+
+            layer.self = 0;
+            layer.other = 0;
+
+            if (i >= numGroups)
+                continue;
+
+            for (std::uint32_t j = 0; j < numGroups; j++)
+            {
+                auto flags = IConfig::GetCollisionLayerFlags(groups[i], groups[j]);
+
+                if (flags.self)
+                    layer.self |= 1ULL << j;
+
+                if (flags.other)
+                    layer.other |= 1ULL << j;
+            }
+        }
     }
 
     void ICollision::Destroy()
@@ -296,18 +822,38 @@ namespace CBP
 #endif
     }
 
-    void ICollision::AddCollisionObject(btCollisionObject* a_collider)
+    void ICollision::AddCollisionObject(
+        btCollisionObject* a_collider,
+        int a_filterGroup,
+        int a_filterMask)
     {
 #if 0
         m_Instance.m_mutex.lock();
 #endif
 
-        GetWorld()->addCollisionObject(a_collider);
+        a_collider->setInterpolationWorldTransform(a_collider->getWorldTransform());
+
+        GetWorld()->addCollisionObject(a_collider, a_filterGroup, a_filterMask);
+
+        m_Instance.m_sweptReset = true;
 
 #if 0
         m_Instance.m_mutex.unlock();
 #endif
     }
+
+    void ICollision::SetCollisionFilter(
+        btCollisionObject* a_collider,
+        int a_filterGroup,
+        int a_filterMask)
+    {
+        if (auto proxy = a_collider->getBroadphaseHandle(); proxy)
+        {
+            proxy->m_collisionFilterGroup = a_filterGroup;
+            proxy->m_collisionFilterMask = a_filterMask;
+        }
+    }
+
     void ICollision::RemoveCollisionObject(btCollisionObject* a_collider)
     {
 #if 0
@@ -316,11 +862,103 @@ namespace CBP
 
         GetWorld()->removeCollisionObject(a_collider);
 
+        m_Instance.m_sweptReset = true;
+
 #if 0
         m_Instance.m_mutex.unlock();
 #endif
     }
 
+    bool ICollision::ccdResultCallback::needsCollision(btBroadphaseProxy* proxy0) const
+    {
+        if (proxy0->m_clientObject == m_self) {
+            return false;
+        }
+
+        return m_Instance.m_overlapFilter.needBroadphaseCollision(
+            m_self->getBroadphaseHandle(), proxy0);
+    }
+
+    void ICollision::GetResponseParams(
+        const SimComponent* a_sca,
+        const SimComponent* a_scb,
+        responseParams_t& a_out)
+    {
+        auto& confa = a_sca->GetConfig();
+        auto& confb = a_scb->GetConfig();
+
+        a_out.mova = a_sca->HasMotion();
+        a_out.movb = a_scb->HasMotion();
+
+        a_out.mia = a_sca->GetMassInverse();
+        a_out.mib = a_scb->GetMassInverse();
+        a_out.miab = a_out.mia + a_out.mib;
+
+        a_out.pbf = std::max(confa.fp.f32.colPenBiasFactor, confb.fp.f32.colPenBiasFactor);
+        a_out.pmi = 1.0f / std::max(confa.fp.f32.colPenMass, confb.fp.f32.colPenMass);
+        a_out.rc = 1.0f + std::max(confa.fp.f32.colRestitutionCoefficient, confb.fp.f32.colRestitutionCoefficient);
+
+        a_out.friction = (a_sca->HasFriction() || a_scb->HasFriction());
+
+        if (a_out.friction) {
+            a_out.fc = confa.fp.f32.colFriction * confb.fp.f32.colFriction;
+        }
+    }
+
+    void ICollision::ResolveContact(
+        SimComponent* a_sca,
+        SimComponent* a_scb,
+        const responseParams_t& a_params,
+        const btVector3& a_normal,
+        btScalar a_depth,
+        float a_timeStep)
+    {
+        auto deltaV(a_scb->GetVelocity() - a_sca->GetVelocity());
+
+        auto impulse = a_normal.dot(deltaV);
+
+        if (a_depth > 0.01f) {
+            impulse += (a_timeStep * (2880.0f * a_params.pbf)) * std::max(a_depth - 0.01f, 0.0f);
+        }
+
+        if (impulse > 0.0f)
+        {
+            auto Jm = impulse / a_params.miab * a_params.rc;
+
+            if (a_params.mova)
+            {
+                a_sca->AddVelocity(a_normal * (Jm * a_params.mia * a_params.pmi));
+            }
+
+            if (a_params.movb)
+            {
+                a_scb->SubVelocity(a_normal * (Jm * a_params.mib * a_params.pmi));
+            }
+        }
+
+        if (a_params.friction)
+        {
+            btVector3 fn;
+
+            impulse = GetFrictionImpulse(deltaV, a_normal, fn);
+
+            if (impulse > 0.0f)
+            {
+                auto Jm = impulse / a_params.miab * a_params.fc;
+
+                if (a_params.mova)
+                {
+                    a_sca->AddVelocity(fn * (Jm * a_params.mia));
+                }
+
+                if (a_params.movb)
+                {
+                    a_scb->SubVelocity(fn * (Jm * a_params.mib));
+                }
+            }
+        }
+    }
+
     void ICollision::PerformCollisionResponse(
         int a_low,
         int a_high,
@@ -344,32 +982,120 @@ namespace CBP
             auto sca = static_cast<SimComponent*>(oba->getUserPointer());
             auto scb = static_cast<SimComponent*>(obb->getUserPointer());
 
-            auto& confa = sca->GetConfig();
-            auto& confb = scb->GetConfig();
-
-            auto mova = sca->HasMotion();
-            auto movb = scb->HasMotion();
+            responseParams_t params;
+            GetResponseParams(sca, scb, params);
 
-            auto mia = sca->GetMassInverse();
-            auto mib = scb->GetMassInverse();
-            auto miab = mia + mib;
+#if 0
+            sc1->Lock();
+            sc2->Lock();
+#endif
 
-            auto pbf = std::max(confa.fp.f32.colPenBiasFactor, confb.fp.f32.colPenBiasFactor);
-            auto pmi = 1.0f / std::max(confa.fp.f32.colPenMass, confb.fp.f32.colPenMass);
-            auto rc = 1.0f + std::max(confa.fp.f32.colRestitutionCoefficient, confb.fp.f32.colRestitutionCoefficient);
+            for (decltype(numContacts) j = 0; j < numContacts; j++)
+            {
+                auto& contactPoint = contactManifold->getContactPoint(j);
 
-            float fc;
-            auto friction = (sca->HasFriction() || scb->HasFriction());
+                auto depth = contactPoint.getDistance();
+                if (depth >= 0.0f) {
+                    continue;
+                }
 
-            if (friction) {
-                fc = confa.fp.f32.colFriction * confb.fp.f32.colFriction;
+                ResolveContact(sca, scb, params, contactPoint.m_normalWorldOnB, -depth, a_timeStep);
             }
 
 #if 0
-            sc1->Lock();
-            sc2->Lock();
+            sc2->Unlock();
+            sc1->Unlock();
 #endif
 
+        }
+    }
+
+    void ICollision::batchContacts_t::Resize(std::size_t a_size)
+    {
+        nx.resize(a_size);
+        ny.resize(a_size);
+        nz.resize(a_size);
+        dvx.resize(a_size);
+        dvy.resize(a_size);
+        dvz.resize(a_size);
+        depth.resize(a_size);
+        pbf.resize(a_size);
+        rcm.resize(a_size);
+        fcm.resize(a_size);
+        pair.resize(a_size);
+    }
+
+    void ICollision::PerformCollisionResponseBatched(
+        int a_numManifolds,
+        float a_timeStep)
+    {
+        auto dispatcher = GetDispatcher();
+
+        auto& pairs = m_Instance.m_batchPairs;
+        auto& c = m_Instance.m_batchContacts;
+
+        pairs.clear();
+
+        std::size_t maxContacts(0);
+
+        for (int i = 0; i < a_numManifolds; i++) {
+            maxContacts += dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+        }
+
+        if (!maxContacts)
+            return;
+
+        c.Resize((maxContacts + 3) & ~std::size_t(3));
+
+        // flatten penetrating contacts, velocities are sampled once per substep and
+        // impulses are split between the contacts of a manifold
+
+        std::size_t n(0);
+
+        for (int i = 0; i < a_numManifolds; i++)
+        {
+            auto contactManifold = dispatcher->getManifoldByIndexInternal(i);
+
+            auto numContacts = contactManifold->getNumContacts();
+
+            int numPenetrating(0);
+
+            for (decltype(numContacts) j = 0; j < numContacts; j++)
+            {
+                if (contactManifold->getContactPoint(j).getDistance() < 0.0f) {
+                    numPenetrating++;
+                }
+            }
+
+            if (!numPenetrating) {
+                continue;
+            }
+
+            auto sca = static_cast<SimComponent*>(contactManifold->getBody0()->getUserPointer());
+            auto scb = static_cast<SimComponent*>(contactManifold->getBody1()->getUserPointer());
+
+            responseParams_t params;
+            GetResponseParams(sca, scb, params);
+
+            auto pairIndex = static_cast<std::uint32_t>(pairs.size());
+
+            pairs.emplace_back(batchPair_t{
+                sca,
+                scb,
+                params.mia * params.pmi,
+                params.mib * params.pmi,
+                params.mia,
+                params.mib,
+                params.mova,
+                params.movb });
+
+            auto w = 1.0f / static_cast<btScalar>(numPenetrating);
+
+            auto deltaV(scb->GetVelocity() - sca->GetVelocity());
+            auto rcm = params.rc / params.miab * w;
+            auto fcm = params.friction ? params.fc / params.miab * w : 0.0f;
+            auto pbf = a_timeStep * (2880.0f * params.pbf);
+
             for (decltype(numContacts) j = 0; j < numContacts; j++)
             {
                 auto& contactPoint = contactManifold->getContactPoint(j);
@@ -379,62 +1105,394 @@ namespace CBP
                     continue;
                 }
 
+                auto& normal = contactPoint.m_normalWorldOnB;
+
+                c.nx[n] = normal.x();
+                c.ny[n] = normal.y();
+                c.nz[n] = normal.z();
+                c.dvx[n] = deltaV.x();
+                c.dvy[n] = deltaV.y();
+                c.dvz[n] = deltaV.z();
+                c.depth[n] = -depth;
+                c.pbf[n] = pbf;
+                c.rcm[n] = rcm;
+                c.fcm[n] = fcm;
+                c.pair[n] = pairIndex;
+
+                n++;
+            }
+        }
+
+        if (!n)
+            return;
+
+        auto padded = (n + 3) & ~std::size_t(3);
+
+        // zeroed padding produces zero impulses
+        for (auto i = n; i < padded; i++)
+        {
+            c.nx[i] = c.ny[i] = c.nz[i] = 0.0f;
+            c.dvx[i] = c.dvy[i] = c.dvz[i] = 0.0f;
+            c.depth[i] = c.pbf[i] = c.rcm[i] = c.fcm[i] = 0.0f;
+        }
+
+        // normal impulses are written back to n*, friction impulses to dv*
+
+        auto zero = _mm_setzero_ps();
+        auto eps2 = _mm_set1_ps(_EPSILON * _EPSILON);
+        auto slop = _mm_set1_ps(0.01f);
+
+        for (std::size_t i = 0; i < padded; i += 4)
+        {
+            auto nx = _mm_loadu_ps(c.nx.data() + i);
+            auto ny = _mm_loadu_ps(c.ny.data() + i);
+            auto nz = _mm_loadu_ps(c.nz.data() + i);
+
+            auto dvx = _mm_loadu_ps(c.dvx.data() + i);
+            auto dvy = _mm_loadu_ps(c.dvy.data() + i);
+            auto dvz = _mm_loadu_ps(c.dvz.data() + i);
+
+            auto dot = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(nx, dvx),
+                _mm_mul_ps(ny, dvy)),
+                _mm_mul_ps(nz, dvz));
+
+            auto bias = _mm_mul_ps(
+                _mm_loadu_ps(c.pbf.data() + i),
+                _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(c.depth.data() + i), slop), zero));
+
+            auto jn = _mm_mul_ps(
+                _mm_max_ps(_mm_add_ps(dot, bias), zero),
+                _mm_loadu_ps(c.rcm.data() + i));
+
+            auto rx = _mm_sub_ps(dvx, _mm_mul_ps(nx, dot));
+            auto ry = _mm_sub_ps(dvy, _mm_mul_ps(ny, dot));
+            auto rz = _mm_sub_ps(dvz, _mm_mul_ps(nz, dot));
+
+            auto l2 = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(rx, rx),
+                _mm_mul_ps(ry, ry)),
+                _mm_mul_ps(rz, rz));
+
+            auto jf = _mm_and_ps(
+                _mm_cmpge_ps(l2, eps2),
+                _mm_loadu_ps(c.fcm.data() + i));
+
+            _mm_storeu_ps(c.nx.data() + i, _mm_mul_ps(nx, jn));
+            _mm_storeu_ps(c.ny.data() + i, _mm_mul_ps(ny, jn));
+            _mm_storeu_ps(c.nz.data() + i, _mm_mul_ps(nz, jn));
+
+            _mm_storeu_ps(c.dvx.data() + i, _mm_mul_ps(rx, jf));
+            _mm_storeu_ps(c.dvy.data() + i, _mm_mul_ps(ry, jf));
+            _mm_storeu_ps(c.dvz.data() + i, _mm_mul_ps(rz, jf));
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            auto& p = pairs[c.pair[i]];
+
+            btVector3 jn(c.nx[i], c.ny[i], c.nz[i]);
+            btVector3 jf(c.dvx[i], c.dvy[i], c.dvz[i]);
+
+            if (p.mova) {
+                p.sca->AddVelocity(jn * p.kna + jf * p.kfa);
+            }
+
+            if (p.movb) {
+                p.scb->SubVelocity(jn * p.knb + jf * p.kfb);
+            }
+        }
+    }
+
+    bool ICollision::HasContacts(
+        const btCollisionObject* a_obj1,
+        const btCollisionObject* a_obj2)
+    {
+        auto pair = GetWorld()->getPairCache()->findPair(
+            a_obj1->getBroadphaseHandle(),
+            a_obj2->getBroadphaseHandle());
+
+        if (!pair || !pair->m_algorithm) {
+            return false;
+        }
+
+        auto& manifolds = m_Instance.m_ccdManifolds;
+
+        manifolds.resize(0);
+        pair->m_algorithm->getAllContactManifolds(manifolds);
+
+        for (int i = 0; i < manifolds.size(); i++)
+        {
+            if (manifolds[i]->getNumContacts() > 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ICollision::PerformContinuousCollisionResponse(
+        float a_timeStep,
+        float a_threshold,
+        float a_maxDiff)
+    {
+        if (a_threshold <= 0.0f)
+        {
+            m_Instance.m_ccdPrimed = false;
+            return;
+        }
+
+        // the first step after enabling only records the start transforms
+        bool primed = m_Instance.m_ccdPrimed;
+        m_Instance.m_ccdPrimed = true;
+
+        auto world = GetWorld();
+        auto& objects = world->getCollisionObjectArray();
+        auto& pairs = m_Instance.m_ccdPairs;
+
+        pairs.clear();
+
+        for (int i = 0; i < objects.size(); i++)
+        {
+            auto obj = objects[i];
+
+            auto& from = obj->getInterpolationWorldTransform();
+            auto& to = obj->getWorldTransform();
+
+            if (!primed) {
+                obj->setInterpolationWorldTransform(to);
+                continue;
+            }
+
+            auto shape = obj->getCollisionShape();
+
+            btScalar radius;
+
+            switch (shape->getShapeType())
+            {
+            case SPHERE_SHAPE_PROXYTYPE:
+                radius = static_cast<const btSphereShape*>(shape)->getRadius();
+                break;
+            case CAPSULE_SHAPE_PROXYTYPE:
+                radius = static_cast<const btCapsuleShape*>(shape)->getRadius();
+                break;
+            default:
+                obj->setInterpolationWorldTransform(to);
+                continue;
+            }
+
+            auto disp(to.getOrigin() - from.getOrigin());
+            auto l2 = disp.length2();
+
+            auto threshold = radius * a_threshold;
+
+            if (l2 <= threshold * threshold ||
+                l2 > a_maxDiff * a_maxDiff)
+            {
+                obj->setInterpolationWorldTransform(to);
+                continue;
+            }
+
+            ccdResultCallback callback(obj, from.getOrigin(), to.getOrigin());
+
+            world->convexSweepTest(
+                static_cast<const btConvexShape*>(shape),
+                from, to, callback);
+
+            obj->setInterpolationWorldTransform(to);
+
+            if (!callback.hasHit()) {
+                continue;
+            }
+
+            auto other = callback.m_hitCollisionObject;
+
+            auto pair = obj < other ?
+                std::make_pair(static_cast<const btCollisionObject*>(obj), other) :
+                std::make_pair(other, static_cast<const btCollisionObject*>(obj));
+
+            if (!pairs.emplace(pair).second) {
+                continue;
+            }
+
+            if (HasContacts(obj, other)) {
+                continue;
+            }
+
+            auto sca = static_cast<SimComponent*>(obj->getUserPointer());
+            auto scb = static_cast<SimComponent*>(other->getUserPointer());
+
+            responseParams_t params;
+            GetResponseParams(sca, scb, params);
+
+            auto& cn = callback.m_hitNormalWorld;
+
+            auto depth = -(disp * (1.0f - callback.m_closestHitFraction)).dot(cn);
+
+            ResolveContact(sca, scb, params, cn, depth, a_timeStep);
+        }
+    }
+
+    void ICollision::ApplySolverImpulse(
+        const solverManifold_t& a_manifold,
+        const btVector3& a_impulse)
+    {
+        if (a_manifold.mova) {
+            a_manifold.sca->AddVelocity(a_impulse * a_manifold.mia);
+        }
+
+        if (a_manifold.movb) {
+            a_manifold.scb->SubVelocity(a_impulse * a_manifold.mib);
+        }
+    }
+
+    void ICollision::PerformCollisionResponseIterative(
+        int a_numManifolds,
+        float a_timeStep,
+        int a_iterations)
+    {
+        auto dispatcher = GetDispatcher();
+
+        auto& manifolds = m_Instance.m_solverManifolds;
+        auto& contacts = m_Instance.m_solverContacts;
+
+        manifolds.clear();
+        contacts.clear();
+
+        for (int i = 0; i < a_numManifolds; i++)
+        {
+            auto contactManifold = dispatcher->getManifoldByIndexInternal(i);
+
+            auto numContacts = contactManifold->getNumContacts();
+
+            if (!numContacts) {
+                continue;
+            }
+
+            auto sca = static_cast<SimComponent*>(contactManifold->getBody0()->getUserPointer());
+            auto scb = static_cast<SimComponent*>(contactManifold->getBody1()->getUserPointer());
+
+            auto& confa = sca->GetConfig();
+            auto& confb = scb->GetConfig();
+
+            solverManifold_t m;
+
+            m.sca = sca;
+            m.scb = scb;
+            m.mova = sca->HasMotion();
+            m.movb = scb->HasMotion();
+            m.mia = sca->GetMassInverse();
+            m.mib = scb->GetMassInverse();
+            m.invMiab = 1.0f / (m.mia + m.mib);
+            m.pmi = 1.0f / std::max(confa.fp.f32.colPenMass, confb.fp.f32.colPenMass);
+            m.friction = sca->HasFriction() || scb->HasFriction();
+            m.fc = m.friction ? confa.fp.f32.colFriction * confb.fp.f32.colFriction : 0.0f;
+            m.first = contacts.size();
+
+            auto pbf = std::max(confa.fp.f32.colPenBiasFactor, confb.fp.f32.colPenBiasFactor);
+            auto rc = std::max(confa.fp.f32.colRestitutionCoefficient, confb.fp.f32.colRestitutionCoefficient);
+
+            for (decltype(numContacts) j = 0; j < numContacts; j++)
+            {
+                auto& contactPoint = contactManifold->getContactPoint(j);
+
+                if (contactPoint.m_lifeTime == 0)
+                {
+                    contactPoint.m_appliedImpulseLateral1 = 0.0f;
+                    contactPoint.m_lateralFrictionDir1.setZero();
+                }
+
+                auto depth = contactPoint.getDistance();
+                if (depth >= 0.0f)
+                {
+                    contactPoint.m_appliedImpulse = 0.0f;
+                    contactPoint.m_appliedImpulseLateral1 = 0.0f;
+                    continue;
+                }
+
                 depth = -depth;
 
                 auto& cn = contactPoint.m_normalWorldOnB;
 
                 auto deltaV(scb->GetVelocity() - sca->GetVelocity());
 
-                auto impulse = cn.dot(deltaV);
+                auto vn = cn.dot(deltaV);
+
+                btScalar bias = vn > 0.0f ? vn * rc : 0.0f;
 
                 if (depth > 0.01f) {
-                    impulse += (a_timeStep * (2880.0f * pbf)) * std::max(depth - 0.01f, 0.0f);
+                    bias += (a_timeStep * (2880.0f * pbf)) * (depth - 0.01f);
                 }
 
-                if (impulse > 0.0f)
+                if (m.friction)
                 {
-                    auto Jm = impulse / miab * rc;
+                    btVector3 fn;
 
-                    if (mova)
+                    if (GetFrictionImpulse(deltaV, cn, fn) > 0.0f)
                     {
-                        sca->AddVelocity(cn * (Jm * mia * pmi));
-                    }
+                        if (fn.dot(contactPoint.m_lateralFrictionDir1) < 0.9f) {
+                            contactPoint.m_appliedImpulseLateral1 = 0.0f;
+                        }
 
-                    if (movb)
-                    {
-                        scb->SubVelocity(cn * (Jm * mib * pmi));
+                        contactPoint.m_lateralFrictionDir1 = fn;
                     }
                 }
+                else {
+                    contactPoint.m_appliedImpulseLateral1 = 0.0f;
+                }
+
+                contactPoint.m_appliedImpulse *= SOLVER_WARMSTART_FACTOR;
+                contactPoint.m_appliedImpulseLateral1 *= SOLVER_WARMSTART_FACTOR;
+
+                ApplySolverImpulse(m,
+                    cn * contactPoint.m_appliedImpulse +
+                    contactPoint.m_lateralFrictionDir1 * contactPoint.m_appliedImpulseLateral1);
+
+                contacts.emplace_back(solverContact_t{ std::addressof(contactPoint), bias });
+            }
+
+            m.last = contacts.size();
+
+            if (m.last > m.first) {
+                manifolds.emplace_back(m);
+            }
+        }
 
-                if (friction)
+        for (int i = 0; i < a_iterations; i++)
+        {
+            for (const auto& m : manifolds)
+            {
+                for (auto k = m.first; k < m.last; k++)
                 {
-                    btVector3 fn;
+                    auto& c = contacts[k];
+                    auto& contactPoint = *c.point;
 
-                    impulse = GetFrictionImpulse(deltaV, cn, fn);
+                    auto& cn = contactPoint.m_normalWorldOnB;
 
-                    if (impulse > 0.0f)
-                    {
-                        auto Jm = impulse / miab * fc;
+                    auto lambda = (cn.dot(m.scb->GetVelocity() - m.sca->GetVelocity()) + c.bias) * m.invMiab * m.pmi;
 
-                        if (mova)
-                        {
-                            sca->AddVelocity(fn * (Jm * mia));
-                        }
+                    auto acc = std::max(contactPoint.m_appliedImpulse + lambda, 0.0f);
+                    lambda = acc - contactPoint.m_appliedImpulse;
+                    contactPoint.m_appliedImpulse = acc;
 
-                        if (movb)
-                        {
-                            scb->SubVelocity(fn * (Jm * mib));
-                        }
+                    ApplySolverImpulse(m, cn * lambda);
+
+                    if (!m.friction) {
+                        continue;
                     }
-                }
 
-            }
+                    auto& fd = contactPoint.m_lateralFrictionDir1;
 
-#if 0
-            sc2->Unlock();
-            sc1->Unlock();
-#endif
+                    auto lambdaT = fd.dot(m.scb->GetVelocity() - m.sca->GetVelocity()) * m.invMiab;
+
+                    auto maxT = m.fc * acc;
+                    auto accT = std::clamp(contactPoint.m_appliedImpulseLateral1 + lambdaT, -maxT, maxT);
+                    lambdaT = accT - contactPoint.m_appliedImpulseLateral1;
+                    contactPoint.m_appliedImpulseLateral1 = accT;
 
+                    ApplySolverImpulse(m, fd * lambdaT);
+                }
+            }
         }
     }
 
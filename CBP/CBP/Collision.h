@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Profile/Profile.h"
+#include "Config.h"
+#include "Profiling.h"
 
 namespace CBP
 {
     struct ColliderData;
+    class SimComponent;
 
     class ColliderProfile :
         public ProfileBase<std::shared_ptr<const ColliderData>, true>,
@@ -26,8 +29,57 @@ namespace CBP
             aiProcess_FindInvalidData |
             aiProcess_RemoveComponent |
             aiProcess_Triangulate |
-            aiProcess_ValidateDataStructure |
-            aiProcess_JoinIdenticalVertices;
+            aiProcess_ValidateDataStructure;
+
+        // exact position matches only, replaces JoinIdenticalVertices
+        static constexpr float WELD_EPSILON = 0.0f;
+
+        static constexpr std::uint32_t CACHE_MAGIC = 'CPBC';
+        static constexpr std::uint32_t CACHE_VERSION = 4;
+
+        enum CacheFlags : std::uint32_t
+        {
+            kHullAliased = 1u << 0
+        };
+
+        // everything the processed data depends on, a mismatch falls back to the importer
+        struct cacheKey_t
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t importFlags;
+            std::uint32_t rvcFlags;
+            float weldEpsilon;
+            std::int32_t hullMaxVertices;
+            std::uint64_t sourceSize;
+            std::int64_t sourceTime;
+
+            SKMP_FORCEINLINE bool operator==(const cacheKey_t& a_rhs) const {
+                return std::memcmp(this, std::addressof(a_rhs), sizeof(cacheKey_t)) == 0;
+            }
+        };
+
+        struct cacheHeader_t
+        {
+            cacheKey_t key;
+            std::uint32_t flags;
+            std::uint32_t numVertices;
+            std::uint32_t numIndices;
+            std::uint32_t numHullPoints;
+            std::uint32_t descLength;
+        };
+
+        static_assert(sizeof(cacheKey_t) == 40);
+        static_assert(sizeof(cacheHeader_t) == 64);
+
+        struct prepared_t
+        {
+            std::unique_ptr<ColliderData> data;
+            std::string desc;
+            cacheKey_t key;
+            bool save;
+            std::exception_ptr error;
+        };
 
     public:
 
@@ -36,26 +88,170 @@ namespace CBP
 
         virtual ~ColliderProfile() noexcept = default;
 
+        virtual void Prepare() override;
         virtual bool Load() override;
         virtual bool Save(const std::shared_ptr<const ColliderData>& a_data, bool a_store) override;
         virtual void SetDefaults() noexcept override;
 
+        // binary sidecar holding the processed data of a_source
+        [[nodiscard]] static fs::path GetCachePath(const fs::path& a_source);
+
         FN_NAMEPROC("ColliderProfile");
+
+    private:
+
+        [[nodiscard]] bool MakeCacheKey(cacheKey_t& a_out) const;
+
+        void Read(prepared_t& a_out) const;
+
+        [[nodiscard]] bool LoadCache(const cacheKey_t& a_key, prepared_t& a_out) const;
+        void SaveCache(const cacheKey_t& a_key, const ColliderData& a_data);
+
+        std::shared_ptr<prepared_t> m_prepared;
     };
 
     class ICollision
     {
+        class collisionWorld :
+            public btCollisionWorld
+        {
+        public:
+            using btCollisionWorld::btCollisionWorld;
+
+            virtual void updateAabbs() override;
+            virtual void computeOverlappingPairs() override;
+            virtual void performDiscreteCollisionDetection() override;
+
+        private:
+            void updateAabbsSwept();
+        };
+
         struct overlapFilter :
             public btOverlapFilterCallback
         {
             virtual bool needBroadphaseCollision(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) const override;
         };
 
+        struct ccdResultCallback :
+            public btCollisionWorld::ClosestConvexResultCallback
+        {
+            ccdResultCallback(
+                const btCollisionObject* a_self,
+                const btVector3& a_from,
+                const btVector3& a_to)
+                :
+                ClosestConvexResultCallback(a_from, a_to),
+                m_self(a_self)
+            {
+            }
+
+            virtual bool needsCollision(btBroadphaseProxy* proxy0) const override;
+
+            const btCollisionObject* m_self;
+        };
+
+        struct responseParams_t
+        {
+            btScalar mia;
+            btScalar mib;
+            btScalar miab;
+            btScalar pbf;
+            btScalar pmi;
+            btScalar rc;
+            btScalar fc;
+
+            bool mova;
+            bool movb;
+            bool friction;
+        };
+
+        struct solverManifold_t
+        {
+            SimComponent* sca;
+            SimComponent* scb;
+
+            btScalar mia;
+            btScalar mib;
+            btScalar invMiab;
+            btScalar pmi;
+            btScalar fc;
+
+            bool mova;
+            bool movb;
+            bool friction;
+
+            std::size_t first;
+            std::size_t last;
+        };
+
+        struct solverContact_t
+        {
+            btManifoldPoint* point;
+            btScalar bias;
+        };
+
+        struct batchPair_t
+        {
+            SimComponent* sca;
+            SimComponent* scb;
+
+            btScalar kna;
+            btScalar knb;
+            btScalar kfa;
+            btScalar kfb;
+
+            bool mova;
+            bool movb;
+        };
+
+        // contacts in SoA layout, padded to a multiple of 4
+        struct batchContacts_t
+        {
+            void Resize(std::size_t a_size);
+
+            std::vector<btScalar> nx, ny, nz;
+            std::vector<btScalar> dvx, dvy, dvz;
+            std::vector<btScalar> depth;
+            std::vector<btScalar> pbf;
+            std::vector<btScalar> rcm;
+            std::vector<btScalar> fcm;
+            std::vector<std::uint32_t> pair;
+        };
+
         static constexpr int MAX_PERSISTENT_MANIFOLD_POOL_SIZE = 4096;
         static constexpr int MAX_COLLISION_ALGORITHM_POOL_SIZE = 4096;
 
+        static constexpr btScalar SOLVER_WARMSTART_FACTOR = 0.85f;
+
+        static constexpr int FILTER_GROUP_INDEX_MASK = 0xFFFF;
+        static constexpr int FILTER_FLAG_MOTION = 1 << 16;
+
+        static constexpr std::uint32_t MAX_COLLISION_LAYERS = 64;
+
+        struct collisionLayer_t
+        {
+            std::uint64_t self;
+            std::uint64_t other;
+        };
+
+        struct sweptState_t
+        {
+            btVector3 origin;
+            btVector3 motion;
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+        };
+
     public:
 
+        [[nodiscard]] SKMP_FORCEINLINE static int MakeFilterGroup(
+            std::uint32_t a_groupIndex,
+            bool a_motion)
+        {
+            return static_cast<int>(a_groupIndex & FILTER_GROUP_INDEX_MASK) |
+                (a_motion ? FILTER_FLAG_MOTION : 0);
+        }
+
         [[nodiscard]] SKMP_FORCEINLINE static auto& GetSingleton() {
             return m_Instance;
         }
@@ -75,10 +271,25 @@ namespace CBP
 
         static void Destroy();
 
+        static void UpdateCollisionLayers();
+
+        [[nodiscard]] SKMP_FORCEINLINE static auto& GetProfiler() {
+            return m_Instance.m_profiler;
+        }
+
+        SKMP_FORCEINLINE static void BeginFrame() {
+            m_Instance.m_sweptFrameStart = true;
+        }
+
         SKMP_FORCEINLINE static void DoCollisionDetection(float a_timeStep);
 
         static void CleanProxyFromPairs(btCollisionObject* a_collider);
-        static void AddCollisionObject(btCollisionObject* a_collider);
+
+        SKMP_FORCEINLINE static void MarkAabbDirty(btCollisionObject* a_collider) {
+            a_collider->setUserIndex(1);
+        }
+        static void AddCollisionObject(btCollisionObject* a_collider, int a_filterGroup, int a_filterMask);
+        static void SetCollisionFilter(btCollisionObject* a_collider, int a_filterGroup, int a_filterMask);
         static void RemoveCollisionObject(btCollisionObject* a_collider);
 
         SKMP_FORCEINLINE static btScalar GetFrictionImpulse(
@@ -92,7 +303,10 @@ namespace CBP
         ICollision& operator=(ICollision&&) = delete;
 
     private:
-        ICollision() = default;
+        ICollision() :
+            m_profiler(1000000)
+        {
+        }
 
         struct
         {
@@ -116,7 +330,36 @@ namespace CBP
             m_Instance.m_ptrs.bt_collision_world->performDiscreteCollisionDetection();
         }
 
+        static void NearCallback(
+            btBroadphasePair& a_pair,
+            btCollisionDispatcher& a_dispatcher,
+            const btDispatcherInfo& a_dispatchInfo);
+
         static void PerformCollisionResponse(int a_low, int a_high, float a_timeStep);
+        static void PerformCollisionResponseIterative(int a_numManifolds, float a_timeStep, int a_iterations);
+        static void PerformCollisionResponseBatched(int a_numManifolds, float a_timeStep);
+        static void PerformContinuousCollisionResponse(float a_timeStep, float a_threshold, float a_maxDiff);
+
+        SKMP_FORCEINLINE static void GetResponseParams(
+            const SimComponent* a_sca,
+            const SimComponent* a_scb,
+            responseParams_t& a_out);
+
+        SKMP_FORCEINLINE static void ResolveContact(
+            SimComponent* a_sca,
+            SimComponent* a_scb,
+            const responseParams_t& a_params,
+            const btVector3& a_normal,
+            btScalar a_depth,
+            float a_timeStep);
+
+        [[nodiscard]] static bool HasContacts(
+            const btCollisionObject* a_obj1,
+            const btCollisionObject* a_obj2);
+
+        SKMP_FORCEINLINE static void ApplySolverImpulse(
+            const solverManifold_t& a_manifold,
+            const btVector3& a_impulse);
 
 #if 0
         struct taskObject_t
@@ -161,6 +404,40 @@ namespace CBP
 #endif
         overlapFilter m_overlapFilter;
 
+        collisionLayer_t m_layers[MAX_COLLISION_LAYERS];
+
+        std::vector<sweptState_t> m_sweptStates;
+        bool m_swept{ false };
+        bool m_sweptFrameStart{ false };
+        bool m_sweptReset{ true };
+        // set when a proxy was moved since the last pair update
+        bool m_proxiesMoved{ true };
+
+        CollisionProfiler m_profiler;
+        bool m_profiling{ false };
+
+        std::vector<solverManifold_t> m_solverManifolds;
+        std::vector<solverContact_t> m_solverContacts;
+
+        std::vector<batchPair_t> m_batchPairs;
+        batchContacts_t m_batchContacts;
+
+        struct ccdPairHasher_t
+        {
+            SKMP_FORCEINLINE std::size_t operator()(const std::pair<const btCollisionObject*, const btCollisionObject*>& a_pair) const noexcept
+            {
+                auto h = std::hash<const void*>()(a_pair.first);
+                h ^= std::hash<const void*>()(a_pair.second) + 0x9e3779b9 + (h << 6) + (h >> 2);
+                return h;
+            }
+        };
+
+        // ordered by address so either sweep direction finds the pair
+        std::unordered_set<std::pair<const btCollisionObject*, const btCollisionObject*>, ccdPairHasher_t> m_ccdPairs;
+        btManifoldArray m_ccdManifolds;
+        // interpolation transforms are only kept while CCD is on
+        bool m_ccdPrimed{ false };
+
         static ICollision m_Instance;
     };
 
@@ -216,7 +493,42 @@ namespace CBP
             task_group.wait();
         }
 #else
-        PerformCollisionResponse(0, numManifolds, a_timeStep);
+        const auto& globalConfig = IConfig::GetGlobal();
+
+        bool profiling = m_Instance.m_profiling;
+
+        auto start = profiling ? IPerfCounter::Query() : 0LL;
+
+        if (globalConfig.phys.iterativeSolver) {
+            PerformCollisionResponseIterative(numManifolds, a_timeStep, globalConfig.phys.solverIterations);
+        }
+        else if (globalConfig.phys.batchedResponse) {
+            PerformCollisionResponseBatched(numManifolds, a_timeStep);
+        }
+        else {
+            PerformCollisionResponse(0, numManifolds, a_timeStep);
+        }
+
+        PerformContinuousCollisionResponse(
+            a_timeStep,
+            globalConfig.phys.ccd ? globalConfig.phys.ccdThreshold : 0.0f,
+            globalConfig.phys.maxDiff);
+
+        if (profiling)
+        {
+            auto ticks = IPerfCounter::Query() - start;
+
+            std::uint32_t numContacts = 0;
+
+            for (int i = 0; i < numManifolds; i++) {
+                numContacts += dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+            }
+
+            m_Instance.m_profiler.AddResponse(
+                ticks,
+                static_cast<std::uint32_t>(numManifolds),
+                numContacts);
+        }
 #endif
 
         /*long long a;
@@ -33,6 +33,10 @@ namespace CBP
             "Convex Hull",
             "A convex hull based on the supplied mesh. Relatively fast collision detection using GJK and EPA. Prefer this over mesh whenever possible."
         }},
+        { ColliderShapeType::ConvexDecomposition, {
+            "Convex Decomposition",
+            "The supplied mesh split into a small set of convex hulls. Follows concave shapes more closely than a single convex hull at a fraction of the cost of mesh."
+        }},
         { ColliderShapeType::Mesh, {
             "Mesh",
             "Concave/convex shape. Uses GIMPACT algorithm. Very expensive, consider using convex hull instead."
@@ -273,7 +277,7 @@ namespace CBP
             0.0f, 50.0f,
             "Extent (X, Y, Z, weight 0)",
             "Extent min",
-            DescUIFlags::Float3 | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::Float3 | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"ey-", {
             offsetof(configComponent_t, fp.f32.colExtentMin[1]),
@@ -281,7 +285,7 @@ namespace CBP
             0.0f, 50.0f,
             "",
             "Extent min",
-            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"ez-", {
             offsetof(configComponent_t, fp.f32.colExtentMin[2]),
@@ -289,7 +293,7 @@ namespace CBP
             0.0f, 50.0f,
             "",
             "Extent min",
-            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"ex+", {
             offsetof(configComponent_t, fp.f32.colExtentMax[0]),
@@ -297,7 +301,7 @@ namespace CBP
             0.0f, 50.0f,
             "Extent (X, Y, Z, weight 100)",
             "Extent max",
-            DescUIFlags::Float3 | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::Float3 | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"ey+", {
             offsetof(configComponent_t, fp.f32.colExtentMax[1]),
@@ -305,7 +309,7 @@ namespace CBP
             0.0f, 50.0f,
             "",
             "Extent max",
-            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"ez+", {
             offsetof(configComponent_t, fp.f32.colExtentMax[2]),
@@ -313,7 +317,7 @@ namespace CBP
             0.0f, 50.0f,
             "",
             "Extent max",
-            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull
+            DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition
         }},
         {"crx", {
             offsetof(configComponent_t, fp.f32.colRot[0]),
@@ -321,7 +325,7 @@ namespace CBP
             -360.0f, 360.0f,
             "Collider rotation in degrees around the X, Y and Z axes respectively.",
             "Collider rotation",
-            DescUIFlags::Float3 | DescUIFlags::Float3Mirror | DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderCone
+            DescUIFlags::Float3 | DescUIFlags::Float3Mirror | DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition | DescUIFlags::ColliderCone
         }},
         {"cry", {
             offsetof(configComponent_t, fp.f32.colRot[1]),
@@ -329,7 +333,7 @@ namespace CBP
             -360.0f, 360.0f,
             "",
             "Collider rotation",
-            DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderCone
+            DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition | DescUIFlags::ColliderCone
         }},
         {"crz", {
             offsetof(configComponent_t, fp.f32.colRot[2]),
@@ -337,7 +341,7 @@ namespace CBP
             -360.0f, 360.0f,
             "",
             "Collider rotation",
-            DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderCone
+            DescUIFlags::ColliderCapsule | DescUIFlags::ColliderBox | DescUIFlags::ColliderMesh | DescUIFlags::ColliderCylinder | DescUIFlags::ColliderTetrahedron | DescUIFlags::ColliderConvexHull | DescUIFlags::ColliderConvexDecomposition | DescUIFlags::ColliderCone
         }},
         {"cb", {
             offsetof(configComponent_t, fp.f32.colRestitutionCoefficient),
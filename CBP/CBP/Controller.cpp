@@ -2,6 +2,7 @@
 
 #include "Controller.h"
 #include "Collision.h"
+#include "BoneCast.h"
 #include "Config.h"
 #include "Renderer.h"
 #include "SimObject.h"
@@ -160,6 +161,8 @@ namespace CBP
     {
         std::uint32_t c(1);
 
+        ICollision::BeginFrame();
+
         while (a_timeStep >= a_maxTime)
         {
             UpdateActorsPhase2(a_timeTick);
@@ -267,7 +270,10 @@ namespace CBP
         auto steps = UpdatePhysics(a_main, a_interval);
 
         if (profiling)
+        {
             m_profiler.End(static_cast<std::uint32_t>(m_actors.size()), steps, a_interval);
+            ICollision::GetProfiler().EndFrame();
+        }
     }
 
     void ControllerTask::Run()
@@ -635,6 +641,9 @@ namespace CBP
             GatherActors(handles);
 
             ClearActors(false, true);
+
+            ICollision::UpdateCollisionLayers();
+
             for (const auto& e : handles)
                 AddActor(e);
 
@@ -900,6 +909,8 @@ namespace CBP
 
     void ControllerTask::ProcessTasks()
     {
+        IBoneCast::ProcessCompleted();
+
         for (;;)
         {
             m_lock.lock();
@@ -963,6 +974,8 @@ namespace CBP
                 break;
             }
         }
+
+        IBoneCast::ProcessPrefetch();
     }
 
     void ControllerTask::GatherActors(handleSet_t& a_out)
@@ -2,6 +2,7 @@
 
 #include "GameEventHandlers.h"
 #include "Controller.h"
+#include "BoneCast.h"
 
 #include "Drivers/cbp.h"
 
@@ -16,6 +17,13 @@ namespace CBP
 
             if (actor)
             {
+                if (evn->loaded)
+                {
+                    Game::VMHandle handle;
+                    if (handle.Get(actor))
+                        IBoneCast::QueuePrefetch(handle, IBoneCast::PrefetchPriority::kHigh);
+                }
+
                 DCBP::DispatchActorTask(
                     actor,
                     evn->loaded ?
@@ -34,8 +42,14 @@ namespace CBP
             if (evn->reference->loadedState && 
                 evn->reference->formType == Actor::kTypeID) 
             {
+                auto actor = static_cast<Actor*>(evn->reference);
+
+                Game::VMHandle handle;
+                if (handle.Get(actor))
+                    IBoneCast::QueuePrefetch(handle, IBoneCast::PrefetchPriority::kLow);
+
                 DCBP::DispatchActorTask(
-                    static_cast<Actor*>(evn->reference),
+                    actor,
                     ControllerInstruction::Action::AddActor);
             }
         }
@@ -69,11 +83,27 @@ namespace CBP
             handle, ControllerInstruction::Action::UpdateArmorOverride);
     }
 
+    SKMP_FORCEINLINE static void PrefetchOnEquip(TESEquipEvent* evn)
+    {
+        auto actor = evn->actor->As<Actor>();
+        if (!actor)
+            return;
+
+        Game::VMHandle handle;
+        if (handle.Get(actor))
+            IBoneCast::QueuePrefetch(handle, IBoneCast::PrefetchPriority::kNormal);
+    }
+
     auto EventHandler::ReceiveEvent(TESEquipEvent* evn, EventDispatcher<TESEquipEvent>*)
         -> EventResult
     {
-        if (evn && evn->actor != nullptr && !evn->equipped)
-            HandleEquipEvent(evn);
+        if (evn && evn->actor != nullptr)
+        {
+            PrefetchOnEquip(evn);
+
+            if (!evn->equipped)
+                HandleEquipEvent(evn);
+        }
 
         return kEvent_Continue;
     }
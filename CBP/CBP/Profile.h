@@ -22,6 +22,8 @@ namespace CBP
 
             using ProfileManager<PhysicsProfile>::ProfileManager;
 
+            virtual void OnProfileDelete(PhysicsProfile& a_profile) override;
+            virtual void OnProfileRename(PhysicsProfile& a_profile, const stl::fixed_string& a_oldName) override;
         };
 
         class ProfileManagerNode :
@@ -34,6 +36,9 @@ namespace CBP
         private:
 
             using ProfileManager<NodeProfile>::ProfileManager;
+
+            virtual void OnProfileDelete(NodeProfile& a_profile) override;
+            virtual void OnProfileRename(NodeProfile& a_profile, const stl::fixed_string& a_oldName) override;
         };
 
         class ProfileManagerCollider :
@@ -46,6 +51,9 @@ namespace CBP
         private:
 
             using ProfileManager<ColliderProfile>::ProfileManager;
+
+            virtual void OnProfileDelete(ColliderProfile& a_profile) override;
+            virtual void OnProfileRename(ColliderProfile& a_profile, const stl::fixed_string& a_oldName) override;
         };
 
 
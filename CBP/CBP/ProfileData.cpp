@@ -7,4 +7,57 @@ namespace CBP
     GlobalProfileManager::ProfileManagerPhysics GlobalProfileManager::m_Instance1("^[a-zA-Z0-9_\\- ]+$");
     GlobalProfileManager::ProfileManagerNode GlobalProfileManager::m_Instance2("^[a-zA-Z0-9_\\- ]+$");
     GlobalProfileManager::ProfileManagerCollider GlobalProfileManager::m_Instance3("^[a-zA-Z0-9_\\- ]+$", ".obj");
+
+    // renaming keeps the write time so the sidecar stays valid
+    static void RenameCache(
+        const fs::path& a_path,
+        const stl::fixed_string& a_oldName,
+        fs::path (*a_getPath)(const fs::path&))
+    {
+        auto oldPath(a_path);
+        oldPath.replace_filename(a_oldName.c_str());
+        oldPath += a_path.extension();
+
+        std::error_code ec;
+        fs::rename(a_getPath(oldPath), a_getPath(a_path), ec);
+    }
+
+    void GlobalProfileManager::ProfileManagerPhysics::OnProfileDelete(PhysicsProfile& a_profile)
+    {
+        std::error_code ec;
+        fs::remove(ProfileCompiledCache::GetPath(a_profile.Path()), ec);
+    }
+
+    void GlobalProfileManager::ProfileManagerPhysics::OnProfileRename(
+        PhysicsProfile& a_profile,
+        const stl::fixed_string& a_oldName)
+    {
+        RenameCache(a_profile.Path(), a_oldName, ProfileCompiledCache::GetPath);
+    }
+
+    void GlobalProfileManager::ProfileManagerNode::OnProfileDelete(NodeProfile& a_profile)
+    {
+        std::error_code ec;
+        fs::remove(ProfileCompiledCache::GetPath(a_profile.Path()), ec);
+    }
+
+    void GlobalProfileManager::ProfileManagerNode::OnProfileRename(
+        NodeProfile& a_profile,
+        const stl::fixed_string& a_oldName)
+    {
+        RenameCache(a_profile.Path(), a_oldName, ProfileCompiledCache::GetPath);
+    }
+
+    void GlobalProfileManager::ProfileManagerCollider::OnProfileDelete(ColliderProfile& a_profile)
+    {
+        std::error_code ec;
+        fs::remove(ColliderProfile::GetCachePath(a_profile.Path()), ec);
+    }
+
+    void GlobalProfileManager::ProfileManagerCollider::OnProfileRename(
+        ColliderProfile& a_profile,
+        const stl::fixed_string& a_oldName)
+    {
+        RenameCache(a_profile.Path(), a_oldName, ColliderProfile::GetCachePath);
+    }
 }
\ No newline at end of file
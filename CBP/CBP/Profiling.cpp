@@ -1,6 +1,9 @@
 #include "pch.h"
 
 #include "Profiling.h"
+#include "SimComponent.h"
+
+#include "Common/Serialization.h"
 
 namespace CBP
 {
@@ -71,4 +74,250 @@ namespace CBP
         m_current.avgTime = 0.0;
         m_current.avgFrameTime = 0.0;
     }
+
+    CollisionProfiler::CollisionProfiler(
+        long long a_interval
+    ) :
+        m_interval(a_interval)
+    {
+        Reset();
+    }
+
+    void CollisionProfiler::AddBroadphase(long long a_ticks, std::uint32_t a_pairs)
+    {
+        m_frame.broadphase += a_ticks;
+        m_frame.pairs += a_pairs;
+        m_frame.steps++;
+    }
+
+    void CollisionProfiler::AddNarrowphase(long long a_ticks)
+    {
+        m_frame.narrowphase += a_ticks;
+    }
+
+    void CollisionProfiler::AddResponse(
+        long long a_ticks,
+        std::uint32_t a_manifolds,
+        std::uint32_t a_contacts)
+    {
+        m_frame.response += a_ticks;
+        m_frame.manifolds += a_manifolds;
+        m_frame.contacts += a_contacts;
+    }
+
+    void CollisionProfiler::AddPair(
+        const SimComponent* a_sca,
+        const SimComponent* a_scb,
+        long long a_ticks)
+    {
+        auto sta = a_sca->GetConfig().ex.colShape;
+        auto stb = a_scb->GetConfig().ex.colShape;
+
+        if (stb < sta)
+            std::swap(sta, stb);
+
+        IScopedLock _(m_lock);
+
+        auto& sp = m_shapePairs[{sta, stb}];
+        sp.time += a_ticks;
+        sp.dispatches++;
+
+        // pair cost is attributed to both colliders
+        for (auto sc : { a_sca, a_scb })
+        {
+            auto& e = m_colliders[{sc->GetFormID(), sc->GetNodeName()}];
+            e.time += a_ticks;
+            e.dispatches++;
+            e.shape = sc->GetConfig().ex.colShape;
+        }
+    }
+
+    void CollisionProfiler::EndFrame()
+    {
+        m_current.lastBroadphase = IPerfCounter::delta_us(0, m_frame.broadphase);
+        m_current.lastNarrowphase = IPerfCounter::delta_us(0, m_frame.narrowphase);
+        m_current.lastResponse = IPerfCounter::delta_us(0, m_frame.response);
+        m_current.lastPairs = m_frame.steps ? m_frame.pairs / m_frame.steps : 0;
+        m_current.lastManifolds = m_frame.steps ? m_frame.manifolds / m_frame.steps : 0;
+        m_current.lastContacts = m_frame.steps ? m_frame.contacts / m_frame.steps : 0;
+        m_current.lastSteps = m_frame.steps;
+
+        m_accum.broadphase += m_frame.broadphase;
+        m_accum.narrowphase += m_frame.narrowphase;
+        m_accum.response += m_frame.response;
+        m_accum.pairs += m_frame.pairs;
+        m_accum.manifolds += m_frame.manifolds;
+        m_accum.contacts += m_frame.contacts;
+        m_accum.steps += m_frame.steps;
+        m_numFrames++;
+
+        m_frame = frame_t();
+
+        auto now = IPerfCounter::Query();
+
+        if (IPerfCounter::delta_us(m_intervalStart, now) < m_interval)
+            return;
+
+        m_intervalStart = now;
+
+        auto numFrames = static_cast<double>(m_numFrames);
+        auto numSteps = static_cast<double>(m_accum.steps);
+
+        m_current.avgBroadphase = static_cast<double>(IPerfCounter::delta_us(0, m_accum.broadphase)) / numFrames;
+        m_current.avgNarrowphase = static_cast<double>(IPerfCounter::delta_us(0, m_accum.narrowphase)) / numFrames;
+        m_current.avgResponse = static_cast<double>(IPerfCounter::delta_us(0, m_accum.response)) / numFrames;
+        m_current.avgSteps = numSteps / numFrames;
+
+        if (m_accum.steps)
+        {
+            m_current.avgPairs = static_cast<double>(m_accum.pairs) / numSteps;
+            m_current.avgManifolds = static_cast<double>(m_accum.manifolds) / numSteps;
+            m_current.avgContacts = static_cast<double>(m_accum.contacts) / numSteps;
+        }
+        else
+        {
+            m_current.avgPairs = 0.0;
+            m_current.avgManifolds = 0.0;
+            m_current.avgContacts = 0.0;
+        }
+
+        {
+            IScopedLock _(m_lock);
+
+            auto& shapePairs = m_current.shapePairs;
+            shapePairs.clear();
+
+            for (auto& e : m_shapePairs)
+            {
+                shapePairs.emplace_back(shapePairStats_t{
+                    e.first.first,
+                    e.first.second,
+                    static_cast<double>(IPerfCounter::delta_us(0, e.second.time)) / numFrames,
+                    static_cast<double>(e.second.dispatches) / numFrames });
+            }
+
+            std::sort(shapePairs.begin(), shapePairs.end(),
+                [](const auto& a_lhs, const auto& a_rhs) {
+                    return a_lhs.avgTime > a_rhs.avgTime; });
+
+            std::vector<std::map<colliderKey_t, colliderAccum_t>::const_iterator> colliders;
+            colliders.reserve(m_colliders.size());
+
+            for (auto it = m_colliders.cbegin(); it != m_colliders.cend(); ++it)
+                colliders.emplace_back(it);
+
+            auto numTop = std::min(colliders.size(), NUM_TOP_COLLIDERS);
+
+            std::partial_sort(colliders.begin(), colliders.begin() + numTop, colliders.end(),
+                [](const auto& a_lhs, const auto& a_rhs) {
+                    return a_lhs->second.time > a_rhs->second.time; });
+
+            auto& topColliders = m_current.topColliders;
+            topColliders.clear();
+
+            for (std::size_t i = 0; i < numTop; i++)
+            {
+                auto& e = *colliders[i];
+
+                topColliders.emplace_back(colliderStats_t{
+                    e.first.first,
+                    e.first.second,
+                    e.second.shape,
+                    static_cast<double>(IPerfCounter::delta_us(0, e.second.time)) / numFrames,
+                    static_cast<double>(e.second.dispatches) / numFrames });
+            }
+
+            m_shapePairs.clear();
+            m_colliders.clear();
+        }
+
+        m_accum = frame_t();
+        m_numFrames = 0;
+
+        m_uid++;
+    }
+
+    void CollisionProfiler::SetInterval(long long a_interval)
+    {
+        m_interval = a_interval;
+    }
+
+    void CollisionProfiler::ResetAccum()
+    {
+        m_frame = frame_t();
+        m_accum = frame_t();
+        m_numFrames = 0;
+        m_intervalStart = IPerfCounter::Query();
+
+        IScopedLock _(m_lock);
+
+        m_shapePairs.clear();
+        m_colliders.clear();
+    }
+
+    void CollisionProfiler::Reset()
+    {
+        ResetAccum();
+
+        m_current = Stats();
+        m_uid = 0;
+    }
+
+    bool CollisionProfiler::DumpToFile(const fs::path& a_path) const
+    {
+        try
+        {
+            Serialization::CreateRootPath(a_path);
+
+            std::ofstream ofs;
+            ofs.open(a_path, std::ofstream::out | std::ofstream::trunc);
+
+            if (!ofs.is_open())
+                throw std::system_error(errno, std::system_category(), a_path.string());
+
+            auto& s = m_current;
+
+            char buf[256];
+
+            _snprintf_s(buf, _TRUNCATE,
+                "Last frame: broadphase %lld us, narrowphase %lld us, response %lld us, steps %u, pairs %u, manifolds %u, contacts %u\n",
+                s.lastBroadphase, s.lastNarrowphase, s.lastResponse, s.lastSteps, s.lastPairs, s.lastManifolds, s.lastContacts);
+            ofs << buf;
+
+            _snprintf_s(buf, _TRUNCATE,
+                "Average: broadphase %.1f us, narrowphase %.1f us, response %.1f us, steps %.2f, pairs %.1f, manifolds %.1f, contacts %.1f\n\n",
+                s.avgBroadphase, s.avgNarrowphase, s.avgResponse, s.avgSteps, s.avgPairs, s.avgManifolds, s.avgContacts);
+            ofs << buf;
+
+            ofs << "Shape pairs (time/frame, dispatches/frame):\n";
+
+            for (auto& e : s.shapePairs)
+            {
+                _snprintf_s(buf, _TRUNCATE, "  %s - %s: %.1f us, %.1f\n",
+                    configComponent_t::colDescMap.at(e.shapeA).name.c_str(),
+                    configComponent_t::colDescMap.at(e.shapeB).name.c_str(),
+                    e.avgTime, e.avgDispatches);
+                ofs << buf;
+            }
+
+            ofs << "\nTop colliders (time/frame, dispatches/frame):\n";
+
+            for (auto& e : s.topColliders)
+            {
+                _snprintf_s(buf, _TRUNCATE, "  %.8X %s [%s]: %.1f us, %.1f\n",
+                    e.actor.get(),
+                    e.node.c_str(),
+                    configComponent_t::colDescMap.at(e.shape).name.c_str(),
+                    e.avgTime, e.avgDispatches);
+                ofs << buf;
+            }
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            m_lastException = e;
+            return false;
+        }
+    }
 }
\ No newline at end of file
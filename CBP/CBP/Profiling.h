@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Config.h"
+
 namespace CBP
 {
+    class SimComponent;
+
     class Profiler
     {
         struct Stats
@@ -42,4 +46,131 @@ namespace CBP
 
         std::uint32_t m_uid;
     };
+
+    class CollisionProfiler
+    {
+    public:
+
+        static constexpr std::size_t NUM_TOP_COLLIDERS = 10;
+
+        struct shapePairStats_t
+        {
+            ColliderShapeType shapeA;
+            ColliderShapeType shapeB;
+            double avgTime;
+            double avgDispatches;
+        };
+
+        struct colliderStats_t
+        {
+            Game::FormID actor;
+            stl::fixed_string node;
+            ColliderShapeType shape;
+            double avgTime;
+            double avgDispatches;
+        };
+
+        struct Stats
+        {
+            // last frame, times in microseconds
+            long long lastBroadphase;
+            long long lastNarrowphase;
+            long long lastResponse;
+            std::uint32_t lastPairs;
+            std::uint32_t lastManifolds;
+            std::uint32_t lastContacts;
+            std::uint32_t lastSteps;
+
+            // interval averages, times are per frame, counts per step
+            double avgBroadphase;
+            double avgNarrowphase;
+            double avgResponse;
+            double avgPairs;
+            double avgManifolds;
+            double avgContacts;
+            double avgSteps;
+
+            std::vector<shapePairStats_t> shapePairs;
+            std::vector<colliderStats_t> topColliders;
+        };
+
+    private:
+
+        struct frame_t
+        {
+            long long broadphase;
+            long long narrowphase;
+            long long response;
+            std::uint32_t pairs;
+            std::uint32_t manifolds;
+            std::uint32_t contacts;
+            std::uint32_t steps;
+        };
+
+        struct accum_t
+        {
+            long long time;
+            std::uint32_t dispatches;
+        };
+
+        using shapePairKey_t = std::pair<ColliderShapeType, ColliderShapeType>;
+        using colliderKey_t = std::pair<Game::FormID, stl::fixed_string>;
+
+        struct colliderAccum_t :
+            accum_t
+        {
+            ColliderShapeType shape;
+        };
+
+    public:
+        CollisionProfiler(long long a_interval);
+
+        void AddBroadphase(long long a_ticks, std::uint32_t a_pairs);
+        void AddNarrowphase(long long a_ticks);
+        void AddResponse(long long a_ticks, std::uint32_t a_manifolds, std::uint32_t a_contacts);
+
+        // thread safe, called from the dispatcher near callback
+        void AddPair(const SimComponent* a_sca, const SimComponent* a_scb, long long a_ticks);
+
+        void EndFrame();
+
+        void SetInterval(long long a_interval);
+        void Reset();
+
+        [[nodiscard]] bool DumpToFile(const fs::path& a_path) const;
+
+        [[nodiscard]] SKMP_FORCEINLINE const auto& Current() const {
+            return m_current;
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE std::uint32_t GetUID() const {
+            return m_uid;
+        }
+
+        [[nodiscard]] SKMP_FORCEINLINE const auto& GetLastException() const {
+            return m_lastException;
+        }
+
+    private:
+
+        void ResetAccum();
+
+        long long m_interval;
+        long long m_intervalStart;
+
+        frame_t m_frame;
+        frame_t m_accum;
+        std::uint32_t m_numFrames;
+
+        std::map<shapePairKey_t, accum_t> m_shapePairs;
+        std::map<colliderKey_t, colliderAccum_t> m_colliders;
+
+        FastSpinMutex m_lock;
+
+        Stats m_current;
+
+        std::uint32_t m_uid;
+
+        mutable except::descriptor m_lastException;
+    };
 }
\ No newline at end of file
@@ -547,6 +547,41 @@ namespace CBP
                 data.phys.maxSubSteps = std::max(phys.get("maxSubSteps", 5.0f).asFloat(), 1.0f);
                 data.phys.maxDiff = std::clamp(phys.get("maxDiff", 355.0f).asFloat(), 200.0f, 2000.0f);
                 data.phys.collision = phys.get("collisions", true).asBool();
+                data.phys.iterativeSolver = phys.get("iterativeSolver", false).asBool();
+                data.phys.solverIterations = std::clamp(phys.get("solverIterations", 4).asInt(), 1, 32);
+                data.phys.batchedResponse = phys.get("batchedResponse", false).asBool();
+                data.phys.ccd = phys.get("ccd", false).asBool();
+                data.phys.ccdThreshold = std::clamp(phys.get("ccdThreshold", 0.5f).asFloat(), 0.05f, 2.0f);
+                data.phys.sweptBroadphase = phys.get("sweptBroadphase", false).asBool();
+
+                if (phys.isMember("collisionMatrix"))
+                {
+                    auto& matrix = phys["collisionMatrix"];
+                    if (matrix.isArray())
+                    {
+                        for (const auto& e : matrix)
+                        {
+                            if (!e.isObject())
+                                continue;
+
+                            auto& g1 = e["g1"];
+                            auto& g2 = e["g2"];
+
+                            if (!g1.isNumeric() || !g2.isNumeric())
+                                continue;
+
+                            auto k = std::minmax(
+                                static_cast<std::uint64_t>(g1.asUInt64()),
+                                static_cast<std::uint64_t>(g2.asUInt64()));
+
+                            data.phys.collisionMatrix.insert_or_assign(
+                                std::make_pair(k.first, k.second),
+                                collisionLayerFlags_t{
+                                    e.get("self", true).asBool(),
+                                    e.get("other", true).asBool() });
+                        }
+                    }
+                }
             }
 
             if (root.isMember("ui"))
@@ -806,6 +841,27 @@ namespace CBP
             phys["maxSubSteps"] = data.phys.maxSubSteps;
             phys["maxDiff"] = data.phys.maxDiff;
             phys["collisions"] = data.phys.collision;
+            phys["iterativeSolver"] = data.phys.iterativeSolver;
+            phys["solverIterations"] = data.phys.solverIterations;
+            phys["batchedResponse"] = data.phys.batchedResponse;
+            phys["ccd"] = data.phys.ccd;
+            phys["ccdThreshold"] = data.phys.ccdThreshold;
+            phys["sweptBroadphase"] = data.phys.sweptBroadphase;
+
+            auto& matrix = phys["collisionMatrix"];
+            matrix = Json::Value(Json::ValueType::arrayValue);
+
+            for (const auto& e : data.phys.collisionMatrix)
+            {
+                Json::Value v;
+
+                v["g1"] = e.first.first;
+                v["g2"] = e.first.second;
+                v["self"] = e.second.self;
+                v["other"] = e.second.other;
+
+                matrix.append(v);
+            }
 
             auto& ui = root["ui"];
 
@@ -0,0 +1,35 @@
+#include "pch.h"
+
+#include "ShapeCache.h"
+#include "ColliderData.h"
+
+namespace CBP
+{
+    ICollisionShapeCache ICollisionShapeCache::m_Instance;
+
+    std::size_t ICollisionShapeCache::hasher_t::operator()(const key_t& a_key) const noexcept
+    {
+        auto h = std::hash<const void*>()(a_key.m_data);
+
+        h ^= std::hash<std::underlying_type_t<ColliderShapeType>>()(
+            static_cast<std::underlying_type_t<ColliderShapeType>>(a_key.m_type)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+        return h;
+    }
+
+    void ICollisionShapeCache::Release(
+        ColliderShapeType a_type,
+        const ColliderData* a_data)
+    {
+        auto it = m_Instance.m_data.find(key_t{ a_type, a_data });
+        if (it == m_Instance.m_data.end())
+            return;
+
+        ASSERT(it->second.m_refCount > 0);
+
+        if (--it->second.m_refCount == 0) {
+            m_Instance.m_data.erase(it);
+        }
+    }
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Config.h"
+
+namespace CBP
+{
+    struct ColliderData;
+
+    // unscaled shapes shared by every collider built from the same ColliderData,
+    // colliders apply their own scale on top. only used with DCBP::GetLock() held.
+    class ICollisionShapeCache
+    {
+        struct key_t
+        {
+            ColliderShapeType m_type;
+            const ColliderData* m_data;
+
+            [[nodiscard]] SKMP_FORCEINLINE bool operator==(const key_t& a_rhs) const
+            {
+                return m_type == a_rhs.m_type &&
+                    m_data == a_rhs.m_data;
+            }
+        };
+
+        struct hasher_t
+        {
+            [[nodiscard]] std::size_t operator()(const key_t& a_key) const noexcept;
+        };
+
+        struct entry_t
+        {
+            std::unique_ptr<btCollisionShape> m_shape;
+            std::shared_ptr<const ColliderData> m_data;
+            std::uint32_t m_refCount;
+        };
+
+        using storage_t = std::unordered_map<key_t, entry_t, hasher_t>;
+
+    public:
+
+        template <class T, class Tf>
+        [[nodiscard]] static T* Acquire(
+            ColliderShapeType a_type,
+            const std::shared_ptr<const ColliderData>& a_data,
+            Tf a_create);
+
+        static void Release(
+            ColliderShapeType a_type,
+            const ColliderData* a_data);
+
+        [[nodiscard]] SKMP_FORCEINLINE static auto GetNumShapes() noexcept {
+            return m_Instance.m_data.size();
+        }
+
+        ICollisionShapeCache(const ICollisionShapeCache&) = delete;
+        ICollisionShapeCache(ICollisionShapeCache&&) = delete;
+        ICollisionShapeCache& operator=(const ICollisionShapeCache&) = delete;
+        ICollisionShapeCache& operator=(ICollisionShapeCache&&) = delete;
+
+    private:
+        ICollisionShapeCache() = default;
+
+        storage_t m_data;
+
+        static ICollisionShapeCache m_Instance;
+    };
+
+    template <class T, class Tf>
+    T* ICollisionShapeCache::Acquire(
+        ColliderShapeType a_type,
+        const std::shared_ptr<const ColliderData>& a_data,
+        Tf a_create)
+    {
+        key_t key{ a_type, a_data.get() };
+
+        auto it = m_Instance.m_data.find(key);
+        if (it == m_Instance.m_data.end())
+        {
+            T* shape = a_create();
+
+            it = m_Instance.m_data.emplace(key, entry_t{
+                std::unique_ptr<btCollisionShape>(shape),
+                a_data,
+                0 }).first;
+        }
+
+        it->second.m_refCount++;
+
+        return static_cast<T*>(it->second.m_shape.get());
+    }
+
+}
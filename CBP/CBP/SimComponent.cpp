@@ -3,10 +3,13 @@
 #include "SimComponent.h"
 #include "SimObject.h"
 #include "Collision.h"
+#include "ShapeCache.h"
 #include "Profile.h"
 #include "GeometryTools.h"
 #include "StringHolder.h"
 
+#include "Drivers/cbp.h"
+
 #include "Common/Game.h"
 
 
@@ -132,6 +135,7 @@ namespace CBP
         m_collider->setCollisionShape(m_shape);
 
         ICollision::CleanProxyFromPairs(m_collider);
+        ICollision::MarkAabbDirty(m_collider);
     }
 
     template <class T>
@@ -336,54 +340,195 @@ namespace CBP
         {-0.471405f, -0.333333f, 0.816497f}
     };
 
-    CollisionShapeMesh::CollisionShapeMesh(
+    template <class T>
+    CollisionShapeShared<T>::CollisionShapeShared(
         btCollisionObject* a_collider,
-        btTriangleIndexVertexArray* a_data,
+        const std::shared_ptr<const ColliderData>& a_data,
         const btVector3& a_extent)
         :
-        CollisionShapeTemplExtent<btGImpactMeshShapePart>(a_collider, a_data, 0),
-        m_triVertexArray(a_data)
+        CollisionShape(1.0f),
+        m_collider(a_collider),
+        m_data(a_data),
+        m_extent(a_extent),
+        m_currentExtent(a_extent)
     {
-        m_extent = m_currentExtent = a_extent;
+    }
 
-        SetShapeProperties(a_extent);
+    template <class T>
+    btCollisionShape* CollisionShapeShared<T>::GetBTShape()
+    {
+        return m_shape.get();
     }
 
-    void CollisionShapeMesh::DoRecreateShape(const btVector3& a_extent)
+    template <class T>
+    void CollisionShapeShared<T>::UpdateShape()
     {
-        RecreateShape(m_triVertexArray, 0);
+        auto extent(m_extent * m_nodeScale);
+        if (extent == m_currentExtent)
+            return;
+
+        m_shape->setLocalScaling(extent);
+
+        m_currentExtent = extent;
+
+        ICollision::MarkAabbDirty(m_collider);
     }
 
-    void CollisionShapeMesh::SetShapeProperties(const btVector3& a_extent)
+    template <class T>
+    void CollisionShapeShared<T>::SetExtent(const btVector3& a_extent)
+    {
+        m_extent = a_extent;
+        UpdateShape();
+    }
+
+    // the GImpact BVH lives in scaled space, so only the vertex array is shared
+    CollisionShapeMesh::CollisionShapeMesh(
+        btCollisionObject* a_collider,
+        const std::shared_ptr<const ColliderData>& a_data,
+        const btVector3& a_extent)
+        :
+        CollisionShapeShared<btGImpactMeshShapePart>(a_collider, a_data, a_extent)
     {
+        m_shape = std::make_unique<btGImpactMeshShapePart>(m_data->m_triVertexArray.get(), 0);
+
         m_shape->setLocalScaling(a_extent);
         m_shape->updateBound();
     }
 
+    void CollisionShapeMesh::UpdateShape()
+    {
+        auto extent(m_extent * m_nodeScale);
+        if (extent == m_currentExtent)
+            return;
+
+        auto tolerance = DCBP::GetDriverConfig().meshScaleTolerance;
+
+        auto diff = (extent - m_currentExtent).absolute();
+        auto limit = m_currentExtent.absolute() * tolerance;
+
+        if (diff.x() <= limit.x() &&
+            diff.y() <= limit.y() &&
+            diff.z() <= limit.z())
+        {
+            return;
+        }
+
+        // keep the BVH topology and refit the node bounds to the new scale
+        m_shape->setLocalScaling(extent);
+        m_shape->updateBound();
+
+        m_currentExtent = extent;
+
+        ICollision::MarkAabbDirty(m_collider);
+    }
+
     CollisionShapeConvexHull::CollisionShapeConvexHull(
         btCollisionObject* a_collider,
-        const MeshPoint* a_data,
-        int a_numVertices,
+        const std::shared_ptr<const ColliderData>& a_data,
         const btVector3& a_extent)
         :
-        CollisionShapeTemplExtent<btConvexHullShape>(a_collider, reinterpret_cast<const btScalar*>(a_data), a_numVertices, sizeof(MeshPoint)),
-        m_convexHullPoints(a_data),
-        m_convexHullNumVertices(a_numVertices)
+        CollisionShapeShared<btConvexPointCloudShape>(a_collider, a_data, a_extent)
     {
-        m_extent = m_currentExtent = a_extent;
+        auto hull = ICollisionShapeCache::Acquire<btConvexHullShape>(
+            ColliderShapeType::ConvexHull, m_data,
+            [this]
+            {
+                return new btConvexHullShape(
+                    reinterpret_cast<const btScalar*>(m_data->m_hullPoints.get()),
+                    m_data->m_numHullPoints,
+                    sizeof(MeshPoint));
+            });
 
-        SetShapeProperties(a_extent);
+        m_shape = std::make_unique<btConvexPointCloudShape>(
+            hull->getUnscaledPoints(),
+            hull->getNumPoints(),
+            a_extent,
+            true);
     }
 
-    void CollisionShapeConvexHull::DoRecreateShape(const btVector3& a_extent)
+    CollisionShapeConvexHull::~CollisionShapeConvexHull() noexcept
     {
-        RecreateShape(reinterpret_cast<const btScalar*>(m_convexHullPoints), m_convexHullNumVertices, sizeof(MeshPoint));
+        m_shape.reset();
+
+        ICollisionShapeCache::Release(ColliderShapeType::ConvexHull, m_data.get());
     }
 
-    void CollisionShapeConvexHull::SetShapeProperties(const btVector3& a_extent)
+    CompoundHullShape::~CompoundHullShape() noexcept
     {
+        for (int i = getNumChildShapes() - 1; i >= 0; i--) {
+            delete getChildShape(i);
+        }
+    }
+
+    CollisionShapeConvexDecomposition::CollisionShapeConvexDecomposition(
+        btCollisionObject* a_collider,
+        const std::shared_ptr<const ColliderData>& a_data,
+        const btVector3& a_extent)
+        :
+        CollisionShapeShared<CompoundHullShape>(a_collider, a_data, a_extent)
+    {
+        auto base = ICollisionShapeCache::Acquire<CompoundHullShape>(
+            ColliderShapeType::ConvexDecomposition, m_data,
+            [this]
+            {
+                const auto& driverConf = DCBP::GetDriverConfig();
+
+                auto& pieces = m_data->GetHullPieces(
+                    driverConf.convexDecompositionMaxPieces,
+                    driverConf.convexDecompositionMaxVertices);
+
+                auto shape = new CompoundHullShape(std::max(static_cast<int>(pieces.size()), 1));
+
+                btTransform transform;
+                transform.setIdentity();
+
+                if (pieces.empty())
+                {
+                    shape->addChildShape(transform, new btConvexHullShape(
+                        reinterpret_cast<const btScalar*>(m_data->m_hullPoints.get()),
+                        m_data->m_numHullPoints,
+                        sizeof(MeshPoint)));
+                }
+                else
+                {
+                    for (auto& e : pieces)
+                    {
+                        shape->addChildShape(transform, new btConvexHullShape(
+                            reinterpret_cast<const btScalar*>(e.m_points.get()),
+                            e.m_numPoints,
+                            sizeof(MeshPoint)));
+                    }
+                }
+
+                return shape;
+            });
+
+        auto numPieces = base->getNumChildShapes();
+
+        m_shape = std::make_unique<CompoundHullShape>(numPieces);
+
+        btTransform transform;
+        transform.setIdentity();
+
+        for (int i = 0; i < numPieces; i++)
+        {
+            auto hull = static_cast<btConvexHullShape*>(base->getChildShape(i));
+
+            m_shape->addChildShape(transform, new btConvexPointCloudShape(
+                hull->getUnscaledPoints(),
+                hull->getNumPoints(),
+                btVector3(1.0f, 1.0f, 1.0f),
+                true));
+        }
+
         m_shape->setLocalScaling(a_extent);
-        m_shape->recalcLocalAabb();
+    }
+
+    CollisionShapeConvexDecomposition::~CollisionShapeConvexDecomposition() noexcept
+    {
+        m_shape.reset();
+
+        ICollisionShapeCache::Release(ColliderShapeType::ConvexDecomposition, m_data.get());
     }
 
     Collider::Collider(
@@ -397,6 +542,8 @@ namespace CBP
         m_nodeScale(1.0f),
         m_parent(a_parent),
         m_shape(ColliderShapeType::Sphere),
+        m_filterGroup(0),
+        m_filterMask(0),
         m_positionScale(1.0f),
         m_rotationScale(1.0f),
         m_doPositionScaling(false),
@@ -415,12 +562,18 @@ namespace CBP
     {
         SelectedItem<BoneCastCache::iterator> boneCastResult;
 
+        bool boneCastAsync = IBoneCast::IsAsync();
+
+        BoneResult asyncResult;
+        bool hasAsyncResult(false);
+
         if (m_created)
         {
             if (m_shape == a_shape)
             {
                 if (a_shape == ColliderShapeType::Mesh ||
-                    a_shape == ColliderShapeType::ConvexHull)
+                    a_shape == ColliderShapeType::ConvexHull ||
+                    a_shape == ColliderShapeType::ConvexDecomposition)
                 {
                     if (auto bonecast = a_nodeConf.bl.b.boneCast;
                         m_bonecast == bonecast)
@@ -441,6 +594,23 @@ namespace CBP
                                     return true;
                                 }
                             }
+
+                            if (boneCastAsync)
+                            {
+                                bool pending;
+
+                                hasAsyncResult = IBoneCast::GetAsync(
+                                    m_parent.m_parent.GetActorHandle(),
+                                    m_parent.m_nodeName,
+                                    a_nodeConf,
+                                    asyncResult,
+                                    pending);
+
+                                // keep the current shape until the update completes
+                                if (pending) {
+                                    return true;
+                                }
+                            }
                         }
                         else
                         {
@@ -489,30 +659,53 @@ namespace CBP
             break;
         case ColliderShapeType::Mesh:
         case ColliderShapeType::ConvexHull:
+        case ColliderShapeType::ConvexDecomposition:
         {
             m_bonecast = a_nodeConf.bl.b.boneCast;
 
             if (a_nodeConf.bl.b.boneCast)
             {
-                if (!boneCastResult)
+                BoneResult result;
+
+                if (hasAsyncResult)
+                {
+                    result = std::move(asyncResult);
+                }
+                else if (boneCastAsync)
                 {
-                    if (!IBoneCast::Get(
+                    bool pending;
+
+                    if (!IBoneCast::GetAsync(
                         m_parent.m_parent.GetActorHandle(),
                         m_parent.m_nodeName,
-                        true,
-                        *boneCastResult))
+                        a_nodeConf,
+                        result,
+                        pending))
                     {
                         return false;
                     }
                 }
-
-                BoneResult result;
-                if (!IBoneCast::ProcessResult(
-                    *boneCastResult,
-                    a_nodeConf,
-                    result))
+                else
                 {
-                    return false;
+                    if (!boneCastResult)
+                    {
+                        if (!IBoneCast::Get(
+                            m_parent.m_parent.GetActorHandle(),
+                            m_parent.m_nodeName,
+                            true,
+                            *boneCastResult))
+                        {
+                            return false;
+                        }
+                    }
+
+                    if (!IBoneCast::ProcessResult(
+                        *boneCastResult,
+                        a_nodeConf,
+                        result))
+                    {
+                        return false;
+                    }
                 }
 
                 m_bcUpdateID = result.updateID;
@@ -543,15 +736,20 @@ namespace CBP
                 m_colliderData = it->second.Data();
             }
 
-            if (a_shape == ColliderShapeType::Mesh)
+            switch (a_shape)
             {
+            case ColliderShapeType::Mesh:
                 colshape = std::make_unique<CollisionShapeMesh>(
-                    collider.get(), m_colliderData->m_triVertexArray.get(), m_parent.m_colExtent);
-            }
-            else
-            {
+                    collider.get(), m_colliderData, m_parent.m_colExtent);
+                break;
+            case ColliderShapeType::ConvexHull:
                 colshape = std::make_unique<CollisionShapeConvexHull>(
-                    collider.get(), m_colliderData->m_hullPoints.get(), m_colliderData->m_numIndices, m_parent.m_colExtent);
+                    collider.get(), m_colliderData, m_parent.m_colExtent);
+                break;
+            default:
+                colshape = std::make_unique<CollisionShapeConvexDecomposition>(
+                    collider.get(), m_colliderData, m_parent.m_colExtent);
+                break;
             }
         }
         break;
@@ -579,7 +777,8 @@ namespace CBP
             m_shape == ColliderShapeType::Tetrahedron ||
             m_shape == ColliderShapeType::Cylinder ||
             m_shape == ColliderShapeType::Mesh ||
-            m_shape == ColliderShapeType::ConvexHull;
+            m_shape == ColliderShapeType::ConvexHull ||
+            m_shape == ColliderShapeType::ConvexDecomposition;
 
         if (!m_rotation)
         {
@@ -622,7 +821,7 @@ namespace CBP
     {
         if (!m_colliderActivated)
         {
-            ICollision::AddCollisionObject(m_collider.get());
+            ICollision::AddCollisionObject(m_collider.get(), m_filterGroup, m_filterMask);
 
             m_colliderActivated = true;
         }
@@ -651,6 +850,16 @@ namespace CBP
             Deactivate();
     }
 
+    void Collider::SetCollisionFilter(int a_group, int a_mask)
+    {
+        m_filterGroup = a_group;
+        m_filterMask = a_mask;
+
+        if (m_colliderActivated) {
+            ICollision::SetCollisionFilter(m_collider.get(), a_group, a_mask);
+        }
+    }
+
     void Collider::Update()
     {
         if (!m_created)
@@ -688,42 +897,51 @@ namespace CBP
 
         auto& transform = m_collider->getWorldTransform();
 
+        btVector3 origin;
+
         if (m_parent.m_motion && m_doPositionScaling)
         {
             if (m_offsetParent)
             {
-                transform.setOrigin(
-                    ((parentWd.m_rotation * (m_bodyOffsetPlusInitial + (m_parent.m_ld * m_positionScale))) *=
-                        m_parent.m_objParent->m_worldTransform.scale) += parentWd.m_position
-                );
+                origin = ((parentWd.m_rotation * (m_bodyOffsetPlusInitial + (m_parent.m_ld * m_positionScale))) *=
+                    m_parent.m_objParent->m_worldTransform.scale) += parentWd.m_position;
             }
             else
             {
-                transform.setOrigin(
-                    (((parentWd.m_rotation * (m_parent.m_nodePosition + (m_parent.m_ld * m_positionScale))) *=
-                        m_parent.m_objParent->m_worldTransform.scale) += ((objmat * m_bodyOffset)) *= nodeScale) += parentWd.m_position
-                );
+                origin = (((parentWd.m_rotation * (m_parent.m_nodePosition + (m_parent.m_ld * m_positionScale))) *=
+                    m_parent.m_objParent->m_worldTransform.scale) += ((objmat * m_bodyOffset)) *= nodeScale) += parentWd.m_position;
             }
         }
         else
         {
             if (m_offsetParent)
             {
-                transform.setOrigin(
-                    ((parentWd.m_rotation * m_bodyOffset) *= m_parent.m_objParent->m_worldTransform.scale) += m_parent.m_wdObject.m_position
-                );
+                origin = ((parentWd.m_rotation * m_bodyOffset) *= m_parent.m_objParent->m_worldTransform.scale) += m_parent.m_wdObject.m_position;
             }
             else
             {
-                transform.setOrigin(
-                    ((objmat * m_bodyOffset) *= nodeScale) += m_parent.m_wdObject.m_position
-                );
+                origin = ((objmat * m_bodyOffset) *= nodeScale) += m_parent.m_wdObject.m_position;
             }
         }
 
+        if ((origin - transform.getOrigin()).length2() > dirtyEpsilon2)
+        {
+            transform.setOrigin(origin);
+            ICollision::MarkAabbDirty(m_collider.get());
+        }
+
         if (m_rotation)
         {
-            transform.setBasis(objmat * m_colRot);
+            auto basis(objmat * m_colRot);
+            auto& current = transform.getBasis();
+
+            if ((basis[0] - current[0]).length2() +
+                (basis[1] - current[1]).length2() +
+                (basis[2] - current[2]).length2() > dirtyEpsilon2)
+            {
+                transform.setBasis(basis);
+                ICollision::MarkAabbDirty(m_collider.get());
+            }
         }
 
         if (nodeScale != m_nodeScale)
@@ -778,6 +996,7 @@ namespace CBP
         m_hasPositionOverride(false),
         m_collider(*this),
         m_groupId(a_groupId),
+        m_groupIndex(0),
         m_rotScaleOn(false),
         //m_hasBound(false),
         m_obj(a_obj),
@@ -814,6 +1033,16 @@ namespace CBP
         m_nodeRotation = m_itrInitialRot;
         m_nodePosition = m_itrInitialPos;
 
+        if (a_groupId != 0)
+        {
+            auto& colGroups = IConfig::GetCollisionGroups();
+
+            auto it = colGroups.find(a_groupId);
+            if (it != colGroups.end()) {
+                m_groupIndex = static_cast<std::uint32_t>(std::distance(colGroups.begin(), it)) + 1;
+            }
+        }
+
         UpdateConfig(a_actor, a_obj->m_parent, nullptr, a_nodeConf, a_collisions, a_motion);
 
         m_oldWorldPos.setValue(
@@ -954,6 +1183,10 @@ namespace CBP
             }
         }
 
+        m_collider.SetCollisionFilter(
+            ICollision::MakeFilterGroup(m_groupIndex, a_motion),
+            static_cast<int>(m_formid.get()));
+
         if (a_collisions)
         {
             ColUpdateWeightData(a_actor, m_conf, a_nodeConf);
@@ -987,6 +1220,7 @@ namespace CBP
                 case ColliderShapeType::Tetrahedron:
                 case ColliderShapeType::Mesh:
                 case ColliderShapeType::ConvexHull:
+                case ColliderShapeType::ConvexDecomposition:
                     m_collider.SetExtent(m_colExtent);
                     m_collider.SetColliderRotation(
                         m_conf.fp.vec.colRot + a_nodeConf.fp.vec.colRot
@@ -186,47 +186,93 @@ namespace CBP
         static const btVector3 m_vertices[4];
     };
 
-    class SKMP_ALIGN_AUTO CollisionShapeMesh :
-        public CollisionShapeTemplExtent<btGImpactMeshShapePart>
+    // per collider shape over data shared through ColliderData and ICollisionShapeCache,
+    // scale changes only touch the local scaling of this instance
+    template <class T>
+    class SKMP_ALIGN_AUTO CollisionShapeShared :
+        public CollisionShape
     {
     public:
-        CollisionShapeMesh(
+
+        [[nodiscard]] virtual btCollisionShape* GetBTShape();
+
+        virtual void UpdateShape();
+        virtual void SetExtent(const btVector3 & a_extent);
+
+    protected:
+
+        CollisionShapeShared(
             btCollisionObject * a_collider,
-            btTriangleIndexVertexArray * a_data,
+            const std::shared_ptr<const ColliderData> &a_data,
             const btVector3 & a_extent);
 
-        virtual void DoRecreateShape(const btVector3 & a_extent);
-        virtual void SetShapeProperties(const btVector3 & a_extent);
+        virtual ~CollisionShapeShared() noexcept = default;
 
-    private:
+        std::unique_ptr<T> m_shape;
+        btCollisionObject* m_collider;
 
-        btTriangleIndexVertexArray* m_triVertexArray;
+        std::shared_ptr<const ColliderData> m_data;
+
+        btVector3 m_extent;
+        btVector3 m_currentExtent;
+    };
+
+    class SKMP_ALIGN_AUTO CollisionShapeMesh :
+        public CollisionShapeShared<btGImpactMeshShapePart>
+    {
+    public:
+        CollisionShapeMesh(
+            btCollisionObject * a_collider,
+            const std::shared_ptr<const ColliderData> &a_data,
+            const btVector3 & a_extent);
+
+        virtual void UpdateShape();
     };
 
     class SKMP_ALIGN_AUTO CollisionShapeConvexHull :
-        public CollisionShapeTemplExtent<btConvexHullShape>
+        public CollisionShapeShared<btConvexPointCloudShape>
     {
     public:
 
         CollisionShapeConvexHull(
             btCollisionObject * a_collider,
-            const MeshPoint *a_data,
-            int a_numVertices,
+            const std::shared_ptr<const ColliderData> &a_data,
             const btVector3 & a_extent);
 
-        virtual void DoRecreateShape(const btVector3 & a_extent);
-        virtual void SetShapeProperties(const btVector3 & a_extent);
+        virtual ~CollisionShapeConvexHull() noexcept;
+    };
 
-    private:
+    class CompoundHullShape :
+        public btCompoundShape
+    {
+    public:
+
+        CompoundHullShape(int a_numPieces) :
+            btCompoundShape(true, a_numPieces)
+        {
+        }
+
+        virtual ~CompoundHullShape() noexcept;
+    };
+
+    class SKMP_ALIGN_AUTO CollisionShapeConvexDecomposition :
+        public CollisionShapeShared<CompoundHullShape>
+    {
+    public:
 
-        const MeshPoint* m_convexHullPoints;
-        int m_convexHullNumVertices;
+        CollisionShapeConvexDecomposition(
+            btCollisionObject * a_collider,
+            const std::shared_ptr<const ColliderData> &a_data,
+            const btVector3 & a_extent);
+
+        virtual ~CollisionShapeConvexDecomposition() noexcept;
     };
 
     class SKMP_ALIGN_AUTO Collider :
         ILog
     {
         inline static constexpr btScalar dtrmul = std::numbers::pi_v<btScalar> / 180.0f;
+        inline static constexpr btScalar dirtyEpsilon2 = 1.0e-8f;
 
     public:
         Collider(SimComponent & a_parent);
@@ -306,6 +352,7 @@ namespace CBP
         }
 
         void SetShouldProcess(bool a_switch);
+        void SetCollisionFilter(int a_group, int a_mask);
 
         SKMP_FORCEINLINE void SetOffsetParent(bool a_switch) {
             m_offsetParent = a_switch;
@@ -330,6 +377,9 @@ namespace CBP
 
         ColliderShapeType m_shape;
 
+        int m_filterGroup;
+        int m_filterMask;
+
         bool m_bonecast;
         BoneCacheUpdateID m_bcUpdateID;
 
@@ -497,6 +547,10 @@ namespace CBP
             return m_nodeName;
         }
 
+        [[nodiscard]] SKMP_FORCEINLINE auto GetFormID() const {
+            return m_formid;
+        }
+
         [[nodiscard]] SKMP_FORCEINLINE bool IsSameGroup(const SimComponent & a_rhs) const
         {
             return a_rhs.m_groupId != 0 && m_groupId != 0 &&
@@ -669,6 +723,7 @@ namespace CBP
         btScalar m_gravForce;
 
         uint64_t m_groupId;
+        std::uint32_t m_groupIndex;
 
         configComponent_t m_conf;
 
@@ -0,0 +1,186 @@
+#include "pch.h"
+
+#include "SkinModelCache.h"
+
+namespace CBP
+{
+    ISkinModelCache ISkinModelCache::m_Instance;
+
+    // archived models can't change while the game is running, loose files can
+    long long ISkinModelCache::GetTimeStamp(const char* a_model)
+    {
+        fs::path path("Data");
+
+        if (_strnicmp(a_model, "meshes\\", 7) != 0) {
+            path /= "meshes";
+        }
+
+        path /= a_model;
+
+        std::error_code ec;
+
+        auto time = fs::last_write_time(path, ec);
+        if (ec) {
+            return 0;
+        }
+
+        return static_cast<long long>(time.time_since_epoch().count());
+    }
+
+    void ISkinModelCache::MakeKey(
+        const char* a_model,
+        const stl::fixed_string& a_nodeName,
+        const stl::fixed_string& a_shape,
+        std::string& a_out)
+    {
+        a_out = a_model;
+        a_out += '|';
+        a_out += a_nodeName.c_str();
+        a_out += '|';
+        a_out += a_shape.c_str();
+
+        std::transform(a_out.begin(), a_out.end(), a_out.begin(), ::tolower);
+    }
+
+    auto ISkinModelCache::GetGeometry(
+        const char* a_model,
+        const stl::fixed_string& a_nodeName,
+        const stl::fixed_string& a_shape,
+        ColliderDataStorage& a_out) -> LookupResult
+    {
+        std::string key;
+        MakeKey(a_model, a_nodeName, a_shape, key);
+
+        auto timeStamp = GetTimeStamp(a_model);
+
+        std::lock_guard<std::mutex> lock(m_Instance.m_lock);
+
+        auto& geometry = m_Instance.m_geometry;
+
+        auto it = geometry.find(key);
+        if (it == geometry.end())
+            return LookupResult::kUnknown;
+
+        if (it->second.m_timeStamp != timeStamp)
+        {
+            m_Instance.RemoveGeometry(it);
+            return LookupResult::kUnknown;
+        }
+
+        auto& lru = m_Instance.m_geometryLru;
+        lru.splice(lru.begin(), lru, it->second.m_lru);
+
+        if (!it->second.m_found)
+            return LookupResult::kNotFound;
+
+        a_out = it->second.m_data;
+
+        return LookupResult::kFound;
+    }
+
+    void ISkinModelCache::AddGeometry(
+        const char* a_model,
+        const stl::fixed_string& a_nodeName,
+        const stl::fixed_string& a_shape,
+        const ColliderDataStorage* a_data)
+    {
+        std::string key;
+        MakeKey(a_model, a_nodeName, a_shape, key);
+
+        auto timeStamp = GetTimeStamp(a_model);
+
+        std::lock_guard<std::mutex> lock(m_Instance.m_lock);
+
+        auto& geometry = m_Instance.m_geometry;
+        auto& lru = m_Instance.m_geometryLru;
+
+        if (auto it = geometry.find(key); it != geometry.end()) {
+            m_Instance.RemoveGeometry(it);
+        }
+
+        lru.emplace_front(key);
+
+        auto& e = geometry.try_emplace(std::move(key)).first->second;
+
+        e.m_timeStamp = timeStamp;
+        e.m_found = a_data != nullptr;
+        e.m_lru = lru.begin();
+
+        if (a_data)
+        {
+            e.m_data = *a_data;
+            e.m_data.UpdateSize();
+
+            m_Instance.m_geometrySize += e.m_data.GetSize();
+        }
+
+        while (geometry.size() > 1 && m_Instance.m_geometrySize > MAX_GEOMETRY_SIZE) {
+            m_Instance.RemoveGeometry(geometry.find(lru.back()));
+        }
+    }
+
+    void ISkinModelCache::RemoveGeometry(const std::unordered_map<std::string, geometryEntry_t>::iterator& a_it)
+    {
+        if (a_it->second.m_found) {
+            m_geometrySize -= a_it->second.m_data.GetSize();
+        }
+
+        m_geometryLru.erase(a_it->second.m_lru);
+        m_geometry.erase(a_it);
+    }
+
+    auto ISkinModelCache::GetModel(const char* a_model) -> model_ptr
+    {
+        auto timeStamp = GetTimeStamp(a_model);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Instance.m_lock);
+
+            auto& models = m_Instance.m_models;
+
+            for (auto it = models.begin(); it != models.end(); ++it)
+            {
+                if (_stricmp(it->m_path.c_str(), a_model) != 0)
+                    continue;
+
+                if (it->m_timeStamp != timeStamp)
+                {
+                    models.erase(it);
+                    break;
+                }
+
+                models.splice(models.begin(), models, it);
+
+                return it->m_model;
+            }
+        }
+
+        // parsed outside the lock, a concurrent load of the same model is harmless
+        auto model = std::make_shared<Util::Model::ModelLoader>();
+
+        if (!model->Load(a_model))
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(m_Instance.m_lock);
+
+        auto& models = m_Instance.m_models;
+
+        models.emplace_front(modelEntry_t{ a_model, timeStamp, model });
+
+        while (models.size() > MAX_MODELS) {
+            models.pop_back();
+        }
+
+        return model;
+    }
+
+    void ISkinModelCache::Release()
+    {
+        std::lock_guard<std::mutex> lock(m_Instance.m_lock);
+
+        m_Instance.m_models.clear();
+        m_Instance.m_geometry.clear();
+        m_Instance.m_geometryLru.clear();
+        m_Instance.m_geometrySize = 0;
+    }
+}
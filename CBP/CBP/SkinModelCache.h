@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ColliderData.h"
+
+#include <ext/Model.h>
+
+namespace CBP
+{
+    // parsed skin models and the geometry extracted from them, shared between
+    // actors wearing the same skin. entries are keyed by model path and
+    // invalidated when the loose file changes.
+    class ISkinModelCache
+    {
+        static constexpr std::size_t MAX_MODELS = 4;
+        static constexpr std::size_t MAX_GEOMETRY_SIZE = 1024 * 1024 * 16;
+
+        using model_ptr = std::shared_ptr<Util::Model::ModelLoader>;
+
+        struct modelEntry_t
+        {
+            std::string m_path;
+            long long m_timeStamp;
+            model_ptr m_model;
+        };
+
+        struct geometryEntry_t
+        {
+            long long m_timeStamp;
+            bool m_found;
+            ColliderDataStorage m_data;
+            std::list<std::string>::iterator m_lru;
+        };
+
+    public:
+
+        enum class LookupResult
+        {
+            kUnknown,
+            kNotFound,
+            kFound
+        };
+
+        [[nodiscard]] static LookupResult GetGeometry(
+            const char* a_model,
+            const stl::fixed_string& a_nodeName,
+            const stl::fixed_string& a_shape,
+            ColliderDataStorage& a_out);
+
+        // a_data is nullptr if the node wasn't found in the model
+        static void AddGeometry(
+            const char* a_model,
+            const stl::fixed_string& a_nodeName,
+            const stl::fixed_string& a_shape,
+            const ColliderDataStorage* a_data);
+
+        // returns nullptr if the model couldn't be loaded
+        [[nodiscard]] static model_ptr GetModel(const char* a_model);
+
+        static void Release();
+
+        ISkinModelCache(const ISkinModelCache&) = delete;
+        ISkinModelCache(ISkinModelCache&&) = delete;
+        ISkinModelCache& operator=(const ISkinModelCache&) = delete;
+        ISkinModelCache& operator=(ISkinModelCache&&) = delete;
+
+    private:
+        ISkinModelCache() = default;
+
+        [[nodiscard]] static long long GetTimeStamp(const char* a_model);
+
+        static void MakeKey(
+            const char* a_model,
+            const stl::fixed_string& a_nodeName,
+            const stl::fixed_string& a_shape,
+            std::string& a_out);
+
+        void RemoveGeometry(const std::unordered_map<std::string, geometryEntry_t>::iterator& a_it);
+
+        // most recently used first
+        std::list<modelEntry_t> m_models;
+
+        std::unordered_map<std::string, geometryEntry_t> m_geometry;
+        std::list<std::string> m_geometryLru;
+        std::size_t m_geometrySize{ 0 };
+
+        std::mutex m_lock;
+
+        static ISkinModelCache m_Instance;
+    };
+}
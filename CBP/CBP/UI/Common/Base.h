@@ -49,7 +49,15 @@ namespace CBP
         frameTimer,
         timePerFrame,
         rotation,
-        controllerStats
+        controllerStats,
+        iterativeSolver,
+        ccd,
+        colMatrix,
+        sweptBroadphase,
+        batchedResponse,
+        colShapePairStats,
+        colTopColliders,
+        boneCastCacheStats
     };
 
     typedef std::pair<const stl::fixed_string, configComponentsGenderRoot_t> actorEntryPhysConf_t;
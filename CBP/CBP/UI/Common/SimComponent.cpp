@@ -458,7 +458,8 @@ namespace CBP
         HelpMarker(desc.desc);
 
         if (a_pair.second.ex.colShape == ColliderShapeType::Mesh ||
-            a_pair.second.ex.colShape == ColliderShapeType::ConvexHull)
+            a_pair.second.ex.colShape == ColliderShapeType::ConvexHull ||
+            a_pair.second.ex.colShape == ColliderShapeType::ConvexDecomposition)
         {
             auto& data = pm.Data();
 
@@ -677,6 +678,9 @@ namespace CBP
                         case ColliderShapeType::ConvexHull:
                             f |= (flags & DescUIFlags::ColliderConvexHull);
                             break;
+                        case ColliderShapeType::ConvexDecomposition:
+                            f |= (flags & DescUIFlags::ColliderConvexDecomposition);
+                            break;
                         }
 
                         if (f == DescUIFlags::None)
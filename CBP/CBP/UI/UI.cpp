@@ -46,7 +46,7 @@ namespace CBP
         m_options(std::make_unique<UIOptions>(*this)),
         m_geometryManager(std::make_unique<UICollisionGeometryManager>(*this, "Collider geometry manager")),
         m_colGroups(std::make_unique<UICollisionGroups>()),
-        m_profiling(std::make_unique<UIProfiling>()),
+        m_profiling(std::make_unique<UIProfiling>(*this)),
         m_log(std::make_unique<UILog>()),
         m_armorOverride(std::make_unique<UIArmorOverrideEditor>(*this)),
         m_nodeMap(std::make_unique<UINodeMap>(*this)),
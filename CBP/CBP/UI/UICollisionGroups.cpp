@@ -98,14 +98,21 @@ namespace CBP
 
                 colGroups.erase(*m_selected);
 
+                IConfig::EraseCollisionLayer(*m_selected);
+
                 m_selected.Clear();
 
                 DCBP::SaveCollisionGroups();
+                DCBP::MarkGlobalsForSave();
                 DCBP::ResetActors();
             }
 
             ImGui::Separator();
 
+            DrawCollisionMatrix();
+
+            ImGui::Separator();
+
             for (auto& e : nodeMap)
             {
                 uint64_t curSel;
@@ -171,5 +178,88 @@ namespace CBP
         ImGui::PopID();
     }
 
+    void UICollisionGroups::DrawCollisionMatrix()
+    {
+        if (!Tree(m_matrixKey, "Collision matrix", false, true))
+            return;
+
+        ImGui::Spacing();
+
+        if (ImGui::RadioButton("Same actor", !m_matrixOther))
+            m_matrixOther = false;
+
+        ImGui::SameLine();
+
+        if (ImGui::RadioButton("Other actors", m_matrixOther))
+            m_matrixOther = true;
+
+        HelpMarker(MiscHelpText::colMatrix);
+
+        auto& colGroups = IConfig::GetCollisionGroups();
+
+        std::vector<uint64_t> groups;
+        groups.reserve(colGroups.size() + 1);
+
+        groups.emplace_back(0);
+        for (const auto& e : colGroups)
+            groups.emplace_back(e);
+
+        auto getName = [](const uint64_t& a_group) {
+            return a_group != 0 ?
+                reinterpret_cast<const char*>(std::addressof(a_group)) :
+                "Ungrouped";
+        };
+
+        int num = static_cast<int>(groups.size());
+
+        ImGui::Spacing();
+
+        ImGui::Columns(num + 1, nullptr, false);
+
+        ImGui::NextColumn();
+
+        for (const auto& e : groups)
+        {
+            ImGui::TextWrapped("%s", getName(e));
+            ImGui::NextColumn();
+        }
+
+        for (int i = 0; i < num; i++)
+        {
+            ImGui::TextWrapped("%s", getName(groups[i]));
+            ImGui::NextColumn();
+
+            for (int j = 0; j < num; j++)
+            {
+                // symmetric, only the upper triangle is editable
+                if (j >= i)
+                {
+                    ImGui::PushID(i * num + j);
+
+                    auto flags = IConfig::GetCollisionLayerFlags(groups[i], groups[j]);
+                    auto& v = m_matrixOther ? flags.other : flags.self;
+
+                    if (ImGui::Checkbox("##cell", std::addressof(v)))
+                    {
+                        IConfig::SetCollisionLayerFlags(groups[i], groups[j], flags);
+
+                        DCBP::MarkGlobalsForSave();
+                        DCBP::ResetActors();
+                    }
+
+                    ImGui::PopID();
+                }
+
+                ImGui::NextColumn();
+            }
+        }
+
+        ImGui::Columns(1);
+
+        ImGui::Spacing();
+
+        ImGui::TreePop();
+    }
+
 
 }
\ No newline at end of file
@@ -15,8 +15,13 @@ namespace CBP
 
         void Draw();
     private:
+        void DrawCollisionMatrix();
+
         SelectedItem<uint64_t> m_selected;
         uint64_t m_input;
+
+        bool m_matrixOther{ false };
+        stl::fixed_string m_matrixKey{ "CollisionGroups#Matrix" };
     };
 
 
@@ -35,6 +35,14 @@ namespace CBP
         case MiscHelpText::timePerFrame: return "Amount of time the physics simulation consumes per frame (in microseconds).";
         case MiscHelpText::rotation: return "Collider rotation in degrees around the Z, Y and Y axes respectively.";
         case MiscHelpText::controllerStats: return "Actor controller prints information to the log. Use this only for debugging.";
+        case MiscHelpText::iterativeSolver: return "Resolve contacts with a warm-started sequential impulse solver. Reaches stable contacts with fewer substeps at the cost of some extra time per step.";
+        case MiscHelpText::ccd: return "Sweep sphere and capsule colliders that move further than threshold * radius per step to catch collisions missed between steps.";
+        case MiscHelpText::colMatrix: return "Which collision groups collide with eachother, for nodes on the same actor and for nodes on different actors. Ungrouped applies to nodes without a group.";
+        case MiscHelpText::sweptBroadphase: return "Find collision pairs once per frame using bounding boxes swept over the expected motion, instead of on every sub step. Reduces collision detection cost when multiple sub steps run per frame.";
+        case MiscHelpText::batchedResponse: return "Resolve all contact points of a step together in SIMD batches. Impulses are computed from velocities at the start of the step and split between the contact points of each pair. Faster with many contacts, response may differ slightly from the default.";
+        case MiscHelpText::colShapePairStats: return "Narrowphase time and dispatch count per frame for each collider shape combination.";
+        case MiscHelpText::colTopColliders: return "Colliders with the highest narrowphase time per frame. The time of each pair is counted for both colliders.";
+        case MiscHelpText::boneCastCacheStats: return "Lookups served from memory, from the compressed cold tier and misses. Evicted entries are kept compressed in the cold tier and are reprocessed when used again.";
         default: return "??";
         }
     }
@@ -144,6 +144,34 @@ namespace CBP
 
                 ImGui::Spacing();
 
+                Checkbox("Iterative collision solver", &globalConfig.phys.iterativeSolver);
+                HelpMarker(MiscHelpText::iterativeSolver);
+
+                if (globalConfig.phys.iterativeSolver)
+                {
+                    if (SliderInt("Solver iterations", &globalConfig.phys.solverIterations, 1, 32))
+                        globalConfig.phys.solverIterations = std::clamp(globalConfig.phys.solverIterations, 1, 32);
+                }
+                else
+                {
+                    Checkbox("Batched collision response", &globalConfig.phys.batchedResponse);
+                    HelpMarker(MiscHelpText::batchedResponse);
+                }
+
+                Checkbox("Continuous collision detection", &globalConfig.phys.ccd);
+                HelpMarker(MiscHelpText::ccd);
+
+                if (globalConfig.phys.ccd)
+                {
+                    if (SliderFloat("CCD threshold", &globalConfig.phys.ccdThreshold, 0.05f, 2.0f, "%.2f"))
+                        globalConfig.phys.ccdThreshold = std::clamp(globalConfig.phys.ccdThreshold, 0.05f, 2.0f);
+                }
+
+                Checkbox("Per-frame broadphase", &globalConfig.phys.sweptBroadphase);
+                HelpMarker(MiscHelpText::sweptBroadphase);
+
+                ImGui::Spacing();
+
                 ImGui::TreePop();
             }
 
@@ -3,8 +3,10 @@
 #include "UIProfiling.h"
 
 #include "CBP/Profiling.h"
+#include "CBP/Collision.h"
 #include "CBP/Renderer.h"
 #include "CBP/BoneCast.h"
+#include "CBP/UI/UI.h"
 
 #include "Drivers/cbp.h"
 #include "Drivers/gui.h"
@@ -13,12 +15,14 @@ namespace CBP
 {
     using namespace UICommon;
 
-    UIProfiling::UIProfiling() :
+    UIProfiling::UIProfiling(UIContext& a_parent) :
+        m_parent(a_parent),
         m_lastUID(0),
         m_plotUpdateTime("Time/frame", ImVec2(0, 30.0f), false, 200),
         m_plotFramerate("Timer", ImVec2(0, 30.0f), false, 200),
         m_lastVMIUpdate(IPerfCounter::Query() - 1000000LL),
-        m_chKey("Stats#Settings")
+        m_chKey("Stats#Settings"),
+        m_chCollisionsKey("Stats#Collisions")
     {
     }
 
@@ -76,6 +80,9 @@ namespace CBP
                 }
 
                 ImGui::TextWrapped("BoneCast cache:");
+                ImGui::TextWrapped("BoneCast cold:");
+                ImGui::TextWrapped("BoneCast hits:");
+                HelpMarker(MiscHelpText::boneCastCacheStats);
                 ImGui::Spacing();
 
 #if defined(SKMP_MEMDBG)
@@ -107,7 +114,12 @@ namespace CBP
                     ImGui::TextWrapped("%lld \xC2\xB5s", dr->GetDrawTime());
                 }
 
-                ImGui::TextWrapped("%zu kb", IBoneCast::GetCacheSize() / std::size_t(1024));
+                auto& bcCache = IBoneCast::GetCacheInfo();
+                auto& bcStats = bcCache.GetStats();
+
+                ImGui::TextWrapped("%zu kb (%zu)", bcCache.GetSize() / std::size_t(1024), bcCache.GetNumEntries());
+                ImGui::TextWrapped("%zu kb (%zu)", bcCache.GetColdSize() / std::size_t(1024), bcCache.GetNumColdEntries());
+                ImGui::TextWrapped("%llu / %llu / %llu", bcStats.hits, bcStats.coldHits, bcStats.misses);
                 ImGui::Spacing();
 
 #if defined(SKMP_MEMDBG)
@@ -151,6 +163,8 @@ namespace CBP
                 }
 
                 ImGui::Separator();
+
+                DrawCollisionStats();
             }
 
             if (CollapsingHeader(m_chKey, "Settings"))
@@ -198,4 +212,139 @@ namespace CBP
         ImGui::PopID();
     }
 
+    void UIProfiling::DrawCollisionStats()
+    {
+        if (!CollapsingHeader(m_chCollisionsKey, "Collisions"))
+            return;
+
+        auto& stats = ICollision::GetProfiler().Current();
+
+        ImGui::PushID("Collisions");
+
+        ImGui::Columns(3, nullptr, false);
+
+        ImGui::NextColumn();
+        ImGui::TextWrapped("Last frame");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("Average");
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Broadphase:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%lld \xC2\xB5s", stats.lastBroadphase);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f \xC2\xB5s", stats.avgBroadphase);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Narrowphase:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%lld \xC2\xB5s", stats.lastNarrowphase);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f \xC2\xB5s", stats.avgNarrowphase);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Response:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%lld \xC2\xB5s", stats.lastResponse);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f \xC2\xB5s", stats.avgResponse);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Steps:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%u", stats.lastSteps);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.2f", stats.avgSteps);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Pairs/step:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%u", stats.lastPairs);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f", stats.avgPairs);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Manifolds/step:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%u", stats.lastManifolds);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f", stats.avgManifolds);
+        ImGui::NextColumn();
+
+        ImGui::TextWrapped("Contacts/step:");
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%u", stats.lastContacts);
+        ImGui::NextColumn();
+        ImGui::TextWrapped("%.1f", stats.avgContacts);
+        ImGui::NextColumn();
+
+        ImGui::Columns(1);
+
+        if (!stats.shapePairs.empty())
+        {
+            ImGui::Spacing();
+            ImGui::TextWrapped("Shape pairs:");
+            HelpMarker(MiscHelpText::colShapePairStats);
+
+            ImGui::Columns(3, nullptr, false);
+
+            for (auto& e : stats.shapePairs)
+            {
+                ImGui::TextWrapped("%s - %s",
+                    configComponent_t::colDescMap.at(e.shapeA).name.c_str(),
+                    configComponent_t::colDescMap.at(e.shapeB).name.c_str());
+                ImGui::NextColumn();
+                ImGui::TextWrapped("%.1f \xC2\xB5s", e.avgTime);
+                ImGui::NextColumn();
+                ImGui::TextWrapped("%.1f", e.avgDispatches);
+                ImGui::NextColumn();
+            }
+
+            ImGui::Columns(1);
+        }
+
+        if (!stats.topColliders.empty())
+        {
+            ImGui::Spacing();
+            ImGui::TextWrapped("Top colliders:");
+            HelpMarker(MiscHelpText::colTopColliders);
+
+            ImGui::Columns(3, nullptr, false);
+
+            for (auto& e : stats.topColliders)
+            {
+                ImGui::TextWrapped("[%.8X] %s (%s)",
+                    e.actor.get(),
+                    e.node.c_str(),
+                    configComponent_t::colDescMap.at(e.shape).name.c_str());
+                ImGui::NextColumn();
+                ImGui::TextWrapped("%.1f \xC2\xB5s", e.avgTime);
+                ImGui::NextColumn();
+                ImGui::TextWrapped("%.1f", e.avgDispatches);
+                ImGui::NextColumn();
+            }
+
+            ImGui::Columns(1);
+        }
+
+        ImGui::Spacing();
+
+        if (ImGui::Button("Dump to file"))
+        {
+            if (!DCBP::DumpCollisionProfile())
+            {
+                m_parent.GetPopupQueue().push(
+                    UIPopupType::Message,
+                    "Error",
+                    "Could not write collision stats:\n\n%s",
+                    ICollision::GetProfiler().GetLastException().what()
+                );
+            }
+        }
+
+        ImGui::PopID();
+
+        ImGui::Separator();
+    }
+
 }
\ No newline at end of file
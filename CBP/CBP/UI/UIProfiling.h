@@ -13,12 +13,17 @@ namespace CBP
     {
 
     public:
-        UIProfiling();
+        UIProfiling(UIContext& a_parent);
 
         void Initialize();
 
         void Draw();
     private:
+
+        void DrawCollisionStats();
+
+        UIContext& m_parent;
+
         std::uint32_t m_lastUID;
 
         UIPlot m_plotUpdateTime;
@@ -27,6 +32,7 @@ namespace CBP
         long long m_lastVMIUpdate;
 
         stl::fixed_string m_chKey;
+        stl::fixed_string m_chCollisionsKey;
     };
 
 
@@ -0,0 +1,55 @@
+#include "pch.h"
+
+#include "VertexWeld.h"
+
+namespace CBP
+{
+    std::size_t VertexWelder::hasher_t::operator()(const cell_t& a_cell) const noexcept
+    {
+        auto h = std::hash<std::int64_t>()(a_cell.x);
+
+        h ^= std::hash<std::int64_t>()(a_cell.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<std::int64_t>()(a_cell.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+        return h;
+    }
+
+    VertexWelder::VertexWelder(float a_epsilon, std::size_t a_maxVertices) :
+        m_epsilon(std::max(a_epsilon, 0.0f)),
+        m_numVertices(0)
+    {
+        m_cells.reserve(a_maxVertices);
+    }
+
+    std::int64_t VertexWelder::Quantize(float a_value) const noexcept
+    {
+        if (m_epsilon == 0.0f)
+        {
+            // adding 0 turns -0 into 0
+            auto value = a_value + 0.0f;
+
+            std::uint32_t bits;
+            std::memcpy(std::addressof(bits), std::addressof(value), sizeof(bits));
+
+            return static_cast<std::int64_t>(bits);
+        }
+
+        // std::round rounds halfway cases away from zero like igl::round
+        return static_cast<std::int64_t>(std::round(a_value / m_epsilon));
+    }
+
+    std::uint32_t VertexWelder::Add(float a_x, float a_y, float a_z, bool& a_added)
+    {
+        auto r = m_cells.try_emplace(
+            cell_t{ Quantize(a_x), Quantize(a_y), Quantize(a_z) },
+            m_numVertices);
+
+        a_added = r.second;
+
+        if (r.second) {
+            m_numVertices++;
+        }
+
+        return r.first->second;
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+namespace CBP
+{
+    // merges positions that round to the same point on an a_epsilon grid, that is
+    // round(p / a_epsilon) per axis in single precision. this is the rule
+    // igl::remove_duplicate_vertices uses, so positions closer than a_epsilon on
+    // either side of a rounding boundary stay apart and there's no chaining.
+    // an epsilon of 0 merges exactly equal positions only (-0 equals 0).
+    class VertexWelder
+    {
+        struct cell_t
+        {
+            std::int64_t x;
+            std::int64_t y;
+            std::int64_t z;
+
+            SKMP_FORCEINLINE bool operator==(const cell_t& a_rhs) const noexcept {
+                return x == a_rhs.x && y == a_rhs.y && z == a_rhs.z;
+            }
+        };
+
+        struct hasher_t
+        {
+            std::size_t operator()(const cell_t& a_cell) const noexcept;
+        };
+
+    public:
+
+        VertexWelder(float a_epsilon, std::size_t a_maxVertices);
+
+        // returns the index of the welded vertex for the position, a_added is set
+        // when it's new (indices are handed out in order)
+        std::uint32_t Add(float a_x, float a_y, float a_z, bool& a_added);
+
+        [[nodiscard]] SKMP_FORCEINLINE auto GetNumVertices() const noexcept {
+            return m_numVertices;
+        }
+
+    private:
+
+        [[nodiscard]] std::int64_t Quantize(float a_value) const noexcept;
+
+        float m_epsilon;
+
+        std::unordered_map<cell_t, std::uint32_t, hasher_t> m_cells;
+        std::uint32_t m_numVertices;
+    };
+
+    // welds and compacts in one pass, vertices no index refers to are dropped and
+    // each welded vertex keeps the first referenced source position.
+    // a_indicesOut may alias a_indices, returns the new vertex count.
+    template <class Tv, class Ti, class To>
+    std::uint32_t WeldVertices(
+        const Tv* a_vertices,
+        std::uint32_t a_numVertices,
+        const Ti* a_indices,
+        std::size_t a_numIndices,
+        float a_epsilon,
+        std::unique_ptr<Tv[]>& a_verticesOut,
+        To* a_indicesOut)
+    {
+        constexpr auto INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        VertexWelder welder(a_epsilon, a_numVertices);
+
+        auto remap = std::make_unique_for_overwrite<std::uint32_t[]>(a_numVertices);
+        std::fill_n(remap.get(), a_numVertices, INVALID_INDEX);
+
+        auto vertices = std::make_unique_for_overwrite<Tv[]>(a_numVertices);
+
+        for (std::size_t i = 0; i < a_numIndices; i++)
+        {
+            auto index = static_cast<std::uint32_t>(a_indices[i]);
+
+            if (index >= a_numVertices)
+                throw std::out_of_range("Vertex index out of range");
+
+            auto& e = remap[index];
+
+            if (e == INVALID_INDEX)
+            {
+                auto& v = a_vertices[index].v;
+
+                bool added;
+                e = welder.Add(v.x(), v.y(), v.z(), added);
+
+                if (added) {
+                    vertices[e] = a_vertices[index];
+                }
+            }
+
+            a_indicesOut[i] = static_cast<To>(e);
+        }
+
+        auto numVertices = welder.GetNumVertices();
+
+        a_verticesOut = std::make_unique_for_overwrite<Tv[]>(numVertices);
+        std::copy_n(vertices.get(), numVertices, a_verticesOut.get());
+
+        return numVertices;
+    }
+}
@@ -49,6 +49,52 @@ namespace CBP
         *this = stl::strip_type<decltype(this)>();
     }
 
+    static SKMP_FORCEINLINE auto MakeCollisionMatrixKey(
+        std::uint64_t a_group1,
+        std::uint64_t a_group2)
+    {
+        return a_group1 < a_group2 ?
+            std::make_pair(a_group1, a_group2) :
+            std::make_pair(a_group2, a_group1);
+    }
+
+    collisionLayerFlags_t IConfig::GetCollisionLayerFlags(
+        std::uint64_t a_group1,
+        std::uint64_t a_group2)
+    {
+        auto& matrix = globalConfig.phys.collisionMatrix;
+
+        auto it = matrix.find(MakeCollisionMatrixKey(a_group1, a_group2));
+        if (it != matrix.end())
+            return it->second;
+
+        // nodes in the same group don't collide with eachother on the same actor
+        return collisionLayerFlags_t{ a_group1 != a_group2 || a_group1 == 0, true };
+    }
+
+    void IConfig::SetCollisionLayerFlags(
+        std::uint64_t a_group1,
+        std::uint64_t a_group2,
+        const collisionLayerFlags_t& a_flags)
+    {
+        globalConfig.phys.collisionMatrix.insert_or_assign(
+            MakeCollisionMatrixKey(a_group1, a_group2), a_flags);
+    }
+
+    void IConfig::EraseCollisionLayer(std::uint64_t a_group)
+    {
+        auto& matrix = globalConfig.phys.collisionMatrix;
+
+        auto it = matrix.begin();
+        while (it != matrix.end())
+        {
+            if (it->first.first == a_group || it->first.second == a_group)
+                it = matrix.erase(it);
+            else
+                ++it;
+        }
+    }
+
     float configPropagate_t::ResolveValue(
         const stl::fixed_string& a_key,
         const float a_value) const
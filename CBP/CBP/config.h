@@ -57,6 +57,14 @@ namespace CBP
     typedef stl::unordered_map_simd<stl::fixed_string, configForce_t> configForceMap_t;
     typedef std::unordered_map<stl::fixed_string, bool> collapsibleStates_t;
 
+    struct collisionLayerFlags_t
+    {
+        bool self;
+        bool other;
+    };
+
+    typedef std::map<std::pair<std::uint64_t, std::uint64_t>, collisionLayerFlags_t> collisionMatrix_t;
+
     struct configGlobalRace_t
     {
         bool playableOnly{ true };
@@ -125,6 +133,13 @@ namespace CBP
             float maxSubSteps{ 10.0f };
             float maxDiff{ 360.0f };
             bool collision{ true };
+            bool iterativeSolver{ false };
+            int solverIterations{ 4 };
+            bool batchedResponse{ false };
+            bool ccd{ false };
+            float ccdThreshold{ 0.5f };
+            bool sweptBroadphase{ false };
+            collisionMatrix_t collisionMatrix;
         } phys;
 
         struct SKMP_ALIGN(16)
@@ -262,6 +277,7 @@ namespace CBP
         MotionConstraintSphere = 1U << 20,
         BeginSubGroup = 1U << 21,
         EndSubGroup = 1U << 22,
+        ColliderConvexDecomposition = 1U << 23,
 
         MotionConstraints = (MotionConstraintBox | MotionConstraintSphere)
     };
@@ -276,7 +292,8 @@ namespace CBP
         DescUIFlags::ColliderTetrahedron |
         DescUIFlags::ColliderCylinder |
         DescUIFlags::ColliderMesh |
-        DescUIFlags::ColliderConvexHull;
+        DescUIFlags::ColliderConvexHull |
+        DescUIFlags::ColliderConvexDecomposition;
 
     enum class DescUIGroupType : std::uint32_t
     {
@@ -295,7 +312,8 @@ namespace CBP
         Tetrahedron = 4,
         Cylinder = 5,
         Mesh = 6,
-        ConvexHull = 7
+        ConvexHull = 7,
+        ConvexDecomposition = 8
     };
 
     enum class MotionConstraints : std::uint32_t
@@ -1007,6 +1025,7 @@ namespace CBP
             case Enum::Underlying(ColliderShapeType::Cylinder):
             case Enum::Underlying(ColliderShapeType::Mesh):
             case Enum::Underlying(ColliderShapeType::ConvexHull):
+            case Enum::Underlying(ColliderShapeType::ConvexDecomposition):
                 return true;
             }
 
@@ -1851,6 +1870,17 @@ namespace CBP
             nodeCollisionGroupMap.clear();
         }
 
+        [[nodiscard]] static collisionLayerFlags_t GetCollisionLayerFlags(
+            std::uint64_t a_group1,
+            std::uint64_t a_group2);
+
+        static void SetCollisionLayerFlags(
+            std::uint64_t a_group1,
+            std::uint64_t a_group2,
+            const collisionLayerFlags_t& a_flags);
+
+        static void EraseCollisionLayer(std::uint64_t a_group);
+
         [[nodiscard]] SKMP_FORCEINLINE static auto& GetGlobalNode() noexcept {
             return nodeGlobalConfig;
         }
@@ -49,6 +49,14 @@ namespace CBP
     constexpr const char* CKEY_BTEPA = "UseEpaPenetrationAlgorithm";
     constexpr const char* CKEY_BTMANIFOLDPOOLSIZE = "MaxPersistentManifoldPoolSize";
     constexpr const char* CKEY_BTALGOPOOLSIZE = "MaxCollisionAlgorithmPoolSize";
+    constexpr const char* CKEY_HULLMAXVERTICES = "ConvexHullMaxVertices";
+    constexpr const char* CKEY_DECOMPMAXPIECES = "ConvexDecompositionMaxPieces";
+    constexpr const char* CKEY_DECOMPMAXVERTICES = "ConvexDecompositionMaxVertices";
+    constexpr const char* CKEY_MESHSCALETOLERANCE = "MeshColliderScaleTolerance";
+    constexpr const char* CKEY_BCWORKERTHREADS = "BoneCastWorkerThreads";
+    constexpr const char* CKEY_BCSTORECOMPRESSION = "BoneCastStoreCompression";
+    constexpr const char* CKEY_BCPREFETCHBUDGET = "BoneCastPrefetchBudget";
+    constexpr const char* CKEY_COMPILEDPROFILES = "CompiledProfiles";
 
     DCBP::DCBP() :
         m_loadInstance(0),
@@ -180,8 +188,11 @@ namespace CBP
         const auto& globalConf = CBP::IConfig::GetGlobal();
         auto& profiler = GetProfiler();
 
-        profiler.SetInterval(static_cast<long long>(
-            std::max(globalConf.profiling.profilingInterval, 10)) * 1000);
+        auto interval = static_cast<long long>(
+            std::max(globalConf.profiling.profilingInterval, 10)) * 1000;
+
+        profiler.SetInterval(interval);
+        CBP::ICollision::GetProfiler().SetInterval(interval);
     }
 
     void DCBP::ApplyForce(
@@ -304,11 +315,31 @@ namespace CBP
     void DCBP::ResetProfiler()
     {
         m_Instance.m_controller->GetProfiler().Reset();
+        CBP::ICollision::GetProfiler().Reset();
     }
 
     void DCBP::SetProfilerInterval(long long a_interval)
     {
         m_Instance.m_controller->GetProfiler().SetInterval(a_interval);
+        CBP::ICollision::GetProfiler().SetInterval(a_interval);
+    }
+
+    bool DCBP::DumpCollisionProfile()
+    {
+        auto path = m_Instance.m_conf.paths.exports / "CollisionProfile.txt";
+
+        auto& profiler = CBP::ICollision::GetProfiler();
+
+        if (!profiler.DumpToFile(path))
+        {
+            m_Instance.Error("%s: [%s] %s", __FUNCTION__,
+                path.string().c_str(), profiler.GetLastException().what());
+            return false;
+        }
+
+        m_Instance.Message("Collision profile written to '%s'", path.string().c_str());
+
+        return true;
     }
 
     uint32_t DCBP::ConfigGetComboKey(int32_t param)
@@ -355,6 +386,14 @@ namespace CBP
         m_conf.useRelativeContactBreakingThreshold = GetConfigValue(CKEY_RELCBTHRESH, true);
         m_conf.maxPersistentManifoldPoolSize = GetConfigValue(CKEY_BTMANIFOLDPOOLSIZE, 4096);
         m_conf.maxCollisionAlgorithmPoolSize = GetConfigValue(CKEY_BTALGOPOOLSIZE, 4096);
+        m_conf.convexHullMaxVertices = std::clamp(GetConfigValue(CKEY_HULLMAXVERTICES, 64), 0, 4096);
+        m_conf.convexDecompositionMaxPieces = std::clamp(GetConfigValue(CKEY_DECOMPMAXPIECES, 8), 0, 64);
+        m_conf.convexDecompositionMaxVertices = std::clamp(GetConfigValue(CKEY_DECOMPMAXVERTICES, 32), 0, 4096);
+        m_conf.meshScaleTolerance = std::clamp(GetConfigValue(CKEY_MESHSCALETOLERANCE, 0.01f), 0.0f, 0.5f);
+        m_conf.boneCastWorkerThreads = std::clamp(GetConfigValue(CKEY_BCWORKERTHREADS, 2), 0, 16);
+        m_conf.boneCastStoreCompression = GetConfigValue(CKEY_BCSTORECOMPRESSION, false);
+        m_conf.boneCastPrefetchBudget = std::clamp(GetConfigValue(CKEY_BCPREFETCHBUDGET, 4), 0, 64);
+        m_conf.compiledProfiles = GetConfigValue(CKEY_COMPILEDPROFILES, true);
 
         m_conf.comboKey = ConfigGetComboKey(GetConfigValue(CKEY_COMBOKEY, 1));
         m_conf.showKey = GetConfigValue<UInt32>(CKEY_SHOWKEY, DIK_END);
@@ -582,13 +621,16 @@ namespace CBP
         PerfTimer pt;
         pt.Start();
 
+        ProfileCompiledCache::SetEnabled(driverConf.compiledProfiles);
+
+        // each manager reads its files in parallel, parsing and logging stay on this thread
         auto& pms = GlobalProfileManager::GetSingleton<PhysicsProfile>();
         pms.Load(driverConf.paths.profilesPhysics);
 
         auto& pmn = GlobalProfileManager::GetSingleton<NodeProfile>();
         pmn.Load(driverConf.paths.profilesNode);
 
-        auto& pmc = GlobalProfileManager::GetSingleton<ColliderProfile>();;
+        auto& pmc = GlobalProfileManager::GetSingleton<ColliderProfile>();
         pmc.Load(driverConf.paths.colliderData);
 
         Debug("Profiles loaded in %fs", pt.Stop());
@@ -657,6 +699,8 @@ namespace CBP
 
         m_Instance.m_controller->ClearActors(true);
 
+        CBP::IBoneCast::Shutdown();
+
         m_Instance.m_renderer.reset();
         m_Instance.m_controller.reset();
         m_Instance.m_uiContext.reset();
@@ -694,6 +738,8 @@ namespace CBP
 
                 CBP::BSStringHolder::Create();
 
+                CBP::IBoneCast::Initialize();
+
                 if (IData::PopulateRaceList())
                     m_Instance.Debug("%zu TESRace forms found", IData::RaceListSize());
 
@@ -747,6 +793,7 @@ namespace CBP
             IScopedLock _(GetLock());
             GetController()->ResetInstructionQueue();
             GetProfiler().Reset();
+            CBP::ICollision::GetProfiler().Reset();
             QueueUIReset();
         }
         ResetActors();
@@ -192,6 +192,7 @@ namespace CBP
 
         static void ResetProfiler();
         static void SetProfilerInterval(long long a_interval);
+        static bool DumpCollisionProfile();
 
         [[nodiscard]] static Profiler& GetProfiler();
 
@@ -307,6 +308,14 @@ namespace CBP
             bool useRelativeContactBreakingThreshold;
             int maxPersistentManifoldPoolSize;
             int maxCollisionAlgorithmPoolSize;
+            int convexHullMaxVertices;
+            int convexDecompositionMaxPieces;
+            int convexDecompositionMaxVertices;
+            float meshScaleTolerance;
+            int boneCastWorkerThreads;
+            bool boneCastStoreCompression;
+            int boneCastPrefetchBudget;
+            bool compiledProfiles;
 
             UInt32 comboKey;
             UInt32 showKey;
@@ -97,6 +97,8 @@ bool ProfileManager<T>::Load(const fs::path& a_path)
 
         m_root = a_path;
 
+        std::vector<fs::path> paths;
+
         for (const auto& entry : fs::directory_iterator(a_path))
         {
             if (!entry.is_regular_file())
@@ -121,11 +123,34 @@ bool ProfileManager<T>::Load(const fs::path& a_path)
                 continue;
             }
 
-            T profile(path);
+            paths.emplace_back(path);
+        }
+
+        // merged and reported in name order
+        std::sort(paths.begin(), paths.end());
+
+        // only file I/O and decoding run in parallel, construction, parsing and
+        // logging stay on this thread
+        std::vector<std::unique_ptr<T>> profiles;
+        profiles.reserve(paths.size());
+
+        for (auto& e : paths) {
+            profiles.emplace_back(std::make_unique<T>(e));
+        }
+
+        concurrency::parallel_for(std::size_t(0), profiles.size(), [&](std::size_t a_index)
+        {
+            profiles[a_index]->Prepare();
+        });
+
+        for (std::size_t i = 0; i < paths.size(); i++)
+        {
+            auto& profile = *profiles[i];
 
-            if (!profile.Load()) {
+            if (!profile.Load())
+            {
                 Warning("Failed loading profile '%s': %s",
-                    filename.c_str(), profile.GetLastException().what());
+                    paths[i].filename().string().c_str(), profile.GetLastException().what());
                 continue;
             }
 
@@ -22,6 +22,10 @@ public:
     {
     }
 
+    // optional first half of Load that may run on a worker thread (file I/O, decoding),
+    // it must not log or touch shared state. Load finishes on the calling thread
+    virtual void Prepare() {}
+
     virtual bool Load() = 0;
     virtual bool Save(const T& a_data, bool a_store) = 0;
     virtual void SetDefaults() noexcept = 0;
@@ -98,6 +102,87 @@ protected:
 
 };
 
+// compiled binary copies of JSON profiles, stored next to the source and loaded
+// instead of parsing it as long as the source size, write time and hash match.
+// the archive layout follows the parsers, so caches are only valid for the build
+// that wrote them
+class ProfileCompiledCache
+{
+public:
+
+    static constexpr std::uint32_t MAGIC = 'FRPC';
+    static constexpr std::uint32_t VERSION = 2;
+
+    struct header_t
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t pluginVersion;
+        std::uint32_t build;
+        std::uint32_t schema;
+        std::uint32_t sourceHash[5];
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+
+        SKMP_FORCEINLINE bool operator==(const header_t& a_rhs) const {
+            return std::memcmp(this, std::addressof(a_rhs), sizeof(header_t)) == 0;
+        }
+    };
+
+    static_assert(sizeof(header_t) == 56);
+
+    [[nodiscard]] static fs::path GetPath(const fs::path& a_source)
+    {
+        auto path(a_source);
+        path += ".cache";
+        return path;
+    }
+
+    [[nodiscard]] static bool MakeHeader(
+        const fs::path& a_source,
+        const std::string& a_data,
+        std::uint32_t a_schema,
+        header_t& a_out)
+    {
+        std::error_code ec;
+
+        auto time = fs::last_write_time(a_source, ec);
+        if (ec)
+            return false;
+
+        std::memset(std::addressof(a_out), 0x0, sizeof(a_out));
+
+        a_out.magic = MAGIC;
+        a_out.version = VERSION;
+        a_out.pluginVersion = MAKE_PLUGIN_VERSION(
+            PLUGIN_VERSION_MAJOR,
+            PLUGIN_VERSION_MINOR,
+            PLUGIN_VERSION_REVISION);
+        a_out.build = static_cast<std::uint32_t>(
+            std::hash<std::string_view>()(PLUGIN_VERSION_VERSTRING));
+        a_out.schema = a_schema;
+        a_out.sourceSize = static_cast<std::uint64_t>(a_data.size());
+        a_out.sourceTime = static_cast<std::int64_t>(time.time_since_epoch().count());
+
+        boost::uuids::detail::sha1 sha1;
+        sha1.process_bytes(a_data.data(), a_data.size());
+        sha1.get_digest(a_out.sourceHash);
+
+        return true;
+    }
+
+    SKMP_FORCEINLINE static void SetEnabled(bool a_switch) noexcept {
+        m_enabled = a_switch;
+    }
+
+    [[nodiscard]] SKMP_FORCEINLINE static bool IsEnabled() noexcept {
+        return m_enabled;
+    }
+
+private:
+    inline static bool m_enabled{ true };
+};
+
 template <class T>
 class Profile :
     public ProfileBase<T>,
@@ -113,10 +198,37 @@ public:
 
     virtual ~Profile() noexcept = default;
 
+    virtual void Prepare() override;
     virtual bool Load() override;
     virtual bool Save(const T& a_data, bool a_store) override;
 
     virtual void SetDefaults() noexcept override;
+
+private:
+
+    struct prepared_t
+    {
+        std::string source;
+        ProfileCompiledCache::header_t header;
+        bool compiled;
+        // empty if the compiled cache is missing or stale
+        std::string archive;
+        std::unique_ptr<Json::Value> root;
+        std::exception_ptr error;
+    };
+
+    // tells profile types apart, parser changes are covered by the build in the header
+    [[nodiscard]] static std::uint32_t GetSchemaID();
+
+    static void ParseSource(const std::string& a_source, Json::Value& a_out);
+
+    void Read(prepared_t& a_out) const;
+
+    [[nodiscard]] bool ReadCompiled(const ProfileCompiledCache::header_t& a_header, std::string& a_out) const;
+    [[nodiscard]] bool LoadCompiled(const std::string& a_archive);
+    void SaveCompiled(const ProfileCompiledCache::header_t& a_header);
+
+    std::shared_ptr<prepared_t> m_prepared;
 };
 
 
@@ -151,20 +263,235 @@ bool Profile<T>::Save(const T& a_data, bool a_store)
 }
 
 template <class T>
-bool Profile<T>::Load()
+std::uint32_t Profile<T>::GetSchemaID()
+{
+    auto h = std::hash<std::string_view>()(typeid(T).name());
+
+    return static_cast<std::uint32_t>(h) ^
+        static_cast<std::uint32_t>(boost::serialization::version<T>::value);
+}
+
+template <class T>
+bool Profile<T>::ReadCompiled(
+    const ProfileCompiledCache::header_t& a_header,
+    std::string& a_out) const
 {
     try
     {
-        if (m_path.empty())
-            throw std::exception("Bad path");
+        std::ifstream ifs;
+        ifs.open(ProfileCompiledCache::GetPath(m_path), std::ifstream::in | std::ifstream::binary, _SH_DENYNO);
+        if (!ifs.is_open())
+            return false;
+
+        ifs.seekg(0, std::ifstream::end);
+        auto size = static_cast<std::size_t>(ifs.tellg());
+        ifs.seekg(0, std::ifstream::beg);
+
+        if (size <= sizeof(ProfileCompiledCache::header_t))
+            return false;
+
+        ProfileCompiledCache::header_t header;
+
+        if (!ifs.read(reinterpret_cast<char*>(std::addressof(header)), sizeof(header)))
+            return false;
+
+        if (!(header == a_header))
+            return false;
+
+        a_out.resize(size - sizeof(header));
+
+        if (!ifs.read(a_out.data(), a_out.size()))
+        {
+            a_out.clear();
+            return false;
+        }
+
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        a_out.clear();
+        return false;
+    }
+}
+
+template <class T>
+bool Profile<T>::LoadCompiled(const std::string& a_archive)
+{
+    try
+    {
+        using namespace boost::iostreams;
+        using namespace boost::archive;
+
+        stream<array_source> in(a_archive.data(), a_archive.size());
+
+        binary_iarchive ia(in);
+
+        std::uint64_t id;
+        bool hasDesc;
+        std::string desc;
+        T tmp;
+
+        ia >> id;
+        ia >> hasDesc;
+        ia >> desc;
+        ia >> tmp;
+
+        m_id = id;
+
+        if (hasDesc)
+            m_desc = std::move(desc);
+        else
+            m_desc.Clear();
+
+        m_data = std::move(tmp);
+
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+template <class T>
+void Profile<T>::SaveCompiled(const ProfileCompiledCache::header_t& a_header)
+{
+    try
+    {
+        std::string buffer;
+
+        buffer.append(reinterpret_cast<const char*>(std::addressof(a_header)), sizeof(a_header));
+
+        {
+            using namespace boost::iostreams;
+            using namespace boost::archive;
+
+            stream<back_insert_device<std::string>> out(buffer);
+
+            binary_oarchive oa(out);
+
+            bool hasDesc(m_desc);
+            std::string desc(hasDesc ? *m_desc : std::string());
+
+            oa << m_id;
+            oa << hasDesc;
+            oa << desc;
+            oa << m_data;
+        }
 
+        auto path = ProfileCompiledCache::GetPath(m_path);
+
+        auto tmpPath(path);
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream ofs;
+            ofs.open(tmpPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc, _SH_DENYWR);
+            if (!ofs.is_open())
+                throw std::exception("Could not open file for writing");
+
+            ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            ofs.write(buffer.data(), buffer.size());
+        }
+
+        fs::rename(tmpPath, path);
+    }
+    catch (const std::exception& e)
+    {
+        Warning("%s: %s: %s", __FUNCTION__, m_pathStr.c_str(), e.what());
+    }
+}
+
+template <class T>
+void Profile<T>::ParseSource(const std::string& a_source, Json::Value& a_out)
+{
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+
+    std::string errors;
+
+    if (!reader->parse(a_source.data(), a_source.data() + a_source.size(), std::addressof(a_out), std::addressof(errors)))
+        throw std::exception(errors.c_str());
+}
+
+// no logging or shared state, runs on worker threads through Prepare
+template <class T>
+void Profile<T>::Read(prepared_t& a_out) const
+{
+    if (m_path.empty())
+        throw std::exception("Bad path");
+
+    {
         std::ifstream fs;
         fs.open(m_path, std::ifstream::in | std::ifstream::binary);
         if (!fs.is_open())
             throw std::exception("Could not open file for reading");
 
-        Json::Value root;
-        fs >> root;
+        fs.seekg(0, std::ifstream::end);
+        a_out.source.resize(static_cast<std::size_t>(fs.tellg()));
+        fs.seekg(0, std::ifstream::beg);
+
+        if (!fs.read(a_out.source.data(), a_out.source.size()))
+            throw std::exception("Could not read file");
+    }
+
+    a_out.compiled =
+        ProfileCompiledCache::IsEnabled() &&
+        ProfileCompiledCache::MakeHeader(m_path, a_out.source, GetSchemaID(), a_out.header);
+
+    if (a_out.compiled && ReadCompiled(a_out.header, a_out.archive))
+        return;
+
+    a_out.root = std::make_unique<Json::Value>();
+
+    ParseSource(a_out.source, *a_out.root);
+}
+
+template <class T>
+void Profile<T>::Prepare()
+{
+    auto prepared = std::make_shared<prepared_t>();
+
+    try
+    {
+        Read(*prepared);
+    }
+    catch (const std::exception&)
+    {
+        prepared->error = std::current_exception();
+    }
+
+    m_prepared = std::move(prepared);
+}
+
+template <class T>
+bool Profile<T>::Load()
+{
+    try
+    {
+        auto prepared = std::move(m_prepared);
+
+        if (!prepared)
+        {
+            prepared = std::make_shared<prepared_t>();
+            Read(*prepared);
+        }
+        else if (prepared->error)
+        {
+            std::rethrow_exception(prepared->error);
+        }
+
+        if (!prepared->archive.empty() && LoadCompiled(prepared->archive))
+            return true;
+
+        if (!prepared->root)
+        {
+            prepared->root = std::make_unique<Json::Value>();
+            ParseSource(prepared->source, *prepared->root);
+        }
+
+        auto& root = *prepared->root;
 
         T tmp;
 
@@ -185,6 +512,9 @@ bool Profile<T>::Load()
 
         m_data = std::move(tmp);
 
+        if (prepared->compiled)
+            SaveCompiled(prepared->header);
+
         return true;
     }
     catch (const std::exception& e)
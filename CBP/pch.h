@@ -39,13 +39,18 @@
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <list>
 #include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <string>
 #include <sstream>
 #include <fstream>
 #include <filesystem>
 #include <queue>
 #include <algorithm>
+#include <numeric>
 #include <regex>
 #include <bitset>
 #include <functional>
@@ -71,6 +76,8 @@
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #endif
 #include <BulletCollision/CollisionShapes/btShapeHull.h>
+#include <BulletCollision/CollisionShapes/btConvexPointCloudShape.h>
+#include <LinearMath/btConvexHullComputer.h>
 #include <BulletCollision/Gimpact/btGImpactShape.h>
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 
@@ -87,6 +94,8 @@
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
@@ -117,8 +126,6 @@
 
 #include <meshoptimizer.h>
 
-#include <igl/remove_duplicate_vertices.h>
-
 #include "imgui/imgui_impl_win32.h"
 #include "imgui/imgui_impl_dx11.h"
 
@@ -0,0 +1,229 @@
+#include "pch.h"
+
+#include "VertexWeld.h"
+
+// usage: CBPTests <fixture directory>
+//
+// welds the fixture meshes and checks the result against the rule
+// igl::remove_duplicate_vertices uses: two positions share a vertex iff
+// round(p / epsilon) matches on every axis (exact equality with epsilon 0).
+
+namespace
+{
+    struct vector_t
+    {
+        float m_x;
+        float m_y;
+        float m_z;
+
+        float x() const noexcept { return m_x; }
+        float y() const noexcept { return m_y; }
+        float z() const noexcept { return m_z; }
+    };
+
+    struct point_t
+    {
+        vector_t v;
+    };
+
+    struct mesh_t
+    {
+        std::vector<point_t> vertices;
+        std::vector<int> indices;
+    };
+
+    int s_failed = 0;
+
+    void Fail(const std::string& a_test, const std::string& a_what)
+    {
+        std::fprintf(stderr, "FAIL %s: %s\n", a_test.c_str(), a_what.c_str());
+        s_failed++;
+    }
+
+    mesh_t LoadObj(const std::string& a_path)
+    {
+        std::ifstream fs(a_path);
+        if (!fs.is_open())
+            throw std::runtime_error("Could not open " + a_path);
+
+        mesh_t mesh;
+        std::string line;
+
+        while (std::getline(fs, line))
+        {
+            std::istringstream ss(line);
+            std::string type;
+
+            if (!(ss >> type))
+                continue;
+
+            if (type == "v")
+            {
+                point_t p;
+                if (!(ss >> p.v.m_x >> p.v.m_y >> p.v.m_z))
+                    throw std::runtime_error("Bad vertex in " + a_path);
+
+                mesh.vertices.push_back(p);
+            }
+            else if (type == "f")
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    std::string e;
+                    if (!(ss >> e))
+                        throw std::runtime_error("Bad face in " + a_path);
+
+                    mesh.indices.push_back(std::stoi(e.substr(0, e.find('/'))) - 1);
+                }
+            }
+        }
+
+        return mesh;
+    }
+
+    bool SameCell(float a_lhs, float a_rhs, float a_epsilon)
+    {
+        if (a_epsilon == 0.0f)
+            return a_lhs == a_rhs;
+
+        return std::round(a_lhs / a_epsilon) == std::round(a_rhs / a_epsilon);
+    }
+
+    bool SameCell(const vector_t& a_lhs, const vector_t& a_rhs, float a_epsilon)
+    {
+        return SameCell(a_lhs.m_x, a_rhs.m_x, a_epsilon) &&
+            SameCell(a_lhs.m_y, a_rhs.m_y, a_epsilon) &&
+            SameCell(a_lhs.m_z, a_rhs.m_z, a_epsilon);
+    }
+
+    void Run(
+        const std::string& a_dir,
+        const char* a_file,
+        float a_epsilon,
+        std::uint32_t a_expected)
+    {
+        char name[128];
+        std::snprintf(name, sizeof(name), "%s (epsilon %g)", a_file, a_epsilon);
+
+        auto mesh = LoadObj(a_dir + "/" + a_file);
+
+        auto numIndices = mesh.indices.size();
+        std::vector<int> out(numIndices);
+        std::unique_ptr<point_t[]> welded;
+
+        auto numVertices = CBP::WeldVertices(
+            mesh.vertices.data(),
+            static_cast<std::uint32_t>(mesh.vertices.size()),
+            mesh.indices.data(),
+            numIndices,
+            a_epsilon,
+            welded,
+            out.data());
+
+        if (numVertices != a_expected)
+        {
+            Fail(name, "expected " + std::to_string(a_expected) +
+                " vertices, got " + std::to_string(numVertices));
+        }
+
+        std::vector<bool> used(numVertices);
+
+        for (std::size_t i = 0; i < numIndices; i++)
+        {
+            auto index = out[i];
+
+            if (index < 0 || static_cast<std::uint32_t>(index) >= numVertices)
+            {
+                Fail(name, "index " + std::to_string(i) + " out of range");
+                return;
+            }
+
+            used[index] = true;
+
+            // welded vertex is a source position from the same cell
+            auto& src = mesh.vertices[mesh.indices[i]].v;
+
+            if (!SameCell(welded[index].v, src, a_epsilon))
+                Fail(name, "index " + std::to_string(i) + " moved to another cell");
+
+            for (std::size_t j = 0; j < i; j++)
+            {
+                bool same = SameCell(src, mesh.vertices[mesh.indices[j]].v, a_epsilon);
+
+                if (same != (out[i] == out[j]))
+                {
+                    Fail(name, "indices " + std::to_string(j) + " and " + std::to_string(i) +
+                        (same ? " weren't welded" : " were welded"));
+                }
+            }
+        }
+
+        if (std::find(used.begin(), used.end(), false) != used.end())
+            Fail(name, "unreferenced vertex in output");
+
+        // first referenced source keeps its position
+        if (numIndices && std::memcmp(
+            std::addressof(welded[out[0]]),
+            std::addressof(mesh.vertices[mesh.indices[0]]),
+            sizeof(point_t)) != 0)
+        {
+            Fail(name, "first vertex was modified");
+        }
+    }
+
+    void RunOutOfRange()
+    {
+        point_t vertices[3]{};
+        int indices[3]{ 0, 1, 3 };
+        int out[3];
+        std::unique_ptr<point_t[]> welded;
+
+        try
+        {
+            CBP::WeldVertices(vertices, 3, indices, 3, 0.0f, welded, out);
+            Fail("out of range", "no exception");
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <fixture directory>\n", argv[0]);
+        return 2;
+    }
+
+    std::string dir(argv[1]);
+
+    try
+    {
+        Run(dir, "cube_split.obj", 0.0f, 8);
+        Run(dir, "cube_split.obj", 1e-5f, 8);
+        Run(dir, "boundary.obj", 1e-5f, 4);
+        Run(dir, "chain.obj", 1e-5f, 3);
+        Run(dir, "unreferenced.obj", 0.0f, 3);
+        Run(dir, "exact.obj", 0.0f, 3);
+        Run(dir, "exact.obj", 1e-5f, 2);
+
+        RunOutOfRange();
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    if (s_failed)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", s_failed);
+        return 1;
+    }
+
+    std::printf("all vertex weld tests passed\n");
+
+    return 0;
+}
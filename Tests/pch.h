@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define SKMP_FORCEINLINE __forceinline
+#else
+#define SKMP_FORCEINLINE inline
+#endif